@@ -47,6 +47,8 @@ struct cloogdomain;
 typedef struct cloogdomain CloogDomain ;
 struct cloogscattering;
 typedef struct cloogscattering CloogScattering;
+struct cloogdomainbox;
+typedef struct cloogdomainbox CloogDomainBox;
 struct osl_relation;
 
 
@@ -81,6 +83,7 @@ void          cloog_scattering_print_constraints(FILE *, CloogScattering *);
 void          cloog_domain_free(CloogDomain *) ;
 void          cloog_scattering_free(CloogScattering *);
 CloogDomain * cloog_domain_copy(CloogDomain *) ;
+CloogDomain * cloog_domain_transfer(CloogDomain *, CloogState *);
 CloogDomain * cloog_domain_convex(CloogDomain * Pol) ;
 CloogDomain * cloog_domain_simple_convex(CloogDomain * domain);
 CloogDomain * cloog_domain_simplify(CloogDomain *, CloogDomain *) ;
@@ -92,6 +95,7 @@ int cloog_domain_follows(CloogDomain *dom1, CloogDomain *dom2, unsigned level);
 CloogDomain * cloog_domain_empty(CloogDomain *model);
 int cloog_domain_is_bounded(CloogDomain *dim, unsigned level);
 CloogDomain *cloog_domain_bound_splitter(CloogDomain *dom, int level);
+CloogDomain *cloog_domain_partial_tiles(CloogDomain *dom, int level);
 
 
 /******************************************************************************
@@ -132,6 +136,24 @@ CloogConstraintSet *cloog_domain_constraints(CloogDomain *);
 int           cloog_domain_isempty(CloogDomain *) ;
 CloogDomain * cloog_domain_universe(CloogState *state, unsigned dim);
 CloogDomain * cloog_domain_project(CloogDomain *, int);
+CloogDomain * cloog_domain_project_cached(CloogState *state, CloogDomain *,
+					  int);
+CloogDomain * cloog_domain_intern(CloogState *state, CloogDomain *);
+CloogDomain * cloog_domain_intersection_cached(CloogState *state,
+					       CloogDomain *, CloogDomain *);
+CloogDomain * cloog_domain_difference_cached(CloogState *state,
+					     CloogDomain *, CloogDomain *);
+CloogDomain * cloog_domain_simplify_cached(CloogState *state,
+					   CloogDomain *, CloogDomain *);
+int           cloog_domain_isempty_cached(CloogState *state, CloogDomain *);
+int           cloog_domain_never_integral_cached(CloogState *state,
+						 CloogDomain *);
+int           cloog_domain_lazy_never_integral(CloogState *state,
+					       CloogDomain *);
+int           cloog_domain_is_bounded_cached(CloogState *state, CloogDomain *,
+					     unsigned level);
+int           cloog_domain_follows_cached(CloogState *state, CloogDomain *,
+					  CloogDomain *, unsigned level);
 CloogDomain * cloog_domain_extend(CloogDomain *, int);
 int           cloog_domain_never_integral(CloogDomain *) ;
 void          cloog_domain_stride(CloogDomain *, int, cloog_int_t *, cloog_int_t *);
@@ -145,8 +167,17 @@ int           cloog_domain_can_unroll(CloogDomain *domain, int level,
 				cloog_int_t *n, CloogConstraint **lb);
 CloogDomain * cloog_domain_fixed_offset(CloogDomain *domain, int level,
 				CloogConstraint *lb, cloog_int_t offset);
+CloogDomain * cloog_domain_shift(CloogDomain *domain, int level, int offset);
+CloogDomain * cloog_domain_residue(CloogDomain *domain, int level,
+				int modulo, int residue);
 int           cloog_domain_lazy_disjoint(CloogDomain *, CloogDomain *) ;
+CloogDomainBox *cloog_domain_box(CloogDomain *domain);
+CloogDomainBox *cloog_domain_box_copy(CloogDomainBox *box);
+void          cloog_domain_box_free(CloogDomainBox *box);
+CloogDomainBox *cloog_domain_box_hull(CloogDomainBox *, CloogDomainBox *);
+int           cloog_domain_box_disjoint(CloogDomainBox *, CloogDomainBox *);
 int           cloog_domain_lazy_equal(CloogDomain *, CloogDomain *) ;
+char *        cloog_domain_to_str(CloogDomain *);
 int           cloog_scattering_lazy_block(CloogScattering *, CloogScattering *,
                                       CloogScatteringList *, int);
 int           cloog_scattering_lazy_isscalar(CloogScattering *, int,
@@ -3,9 +3,21 @@
 
 #include <isl/constraint.h>
 
+struct cloog_domain_table;
+struct cloog_domain_facts;
+
 struct cloogbackend {
 	struct isl_ctx	*ctx;
 	unsigned	ctx_allocated : 1;
+	int		max_operations;
+	struct cloog_domain_table *projections;
+	struct cloog_domain_table *interned;
+	struct cloog_domain_table *memo;
+	struct cloog_domain_table *follows;
+	struct cloog_domain_facts *facts;
 };
 
+void cloog_domain_table_free(struct cloog_domain_table *table);
+void cloog_domain_facts_free(struct cloog_domain_facts *facts);
+
 #endif /* define _H */
@@ -90,6 +90,7 @@ void cloog_loop_print(FILE *, CloogLoop *) ;
  *                         Memory deallocation function                       *
  ******************************************************************************/
 void cloog_loop_free(CloogLoop *) ;
+void cloog_loop_components_free(CloogComponents *components);
 
 
 /******************************************************************************
@@ -106,9 +107,16 @@ CloogLoop * cloog_loop_read(CloogState *state,
  ******************************************************************************/
 CloogLoop * cloog_loop_block(CloogLoop *loop, int *scaldims, int nb_scattdims);
 CloogLoop * cloog_loop_malloc(CloogState *state);
+CloogLoop * cloog_loop_copy(CloogLoop *source);
+CloogLoop * cloog_loop_concat(CloogLoop *a, CloogLoop *b);
+CloogComponents *cloog_loop_components_alloc(void);
 CloogLoop *cloog_loop_generate(CloogLoop *loop, CloogDomain *context,
 	int level, int scalar, int *scaldims, int nb_scattdims,
 	CloogOptions *options);
+CloogLoop * cloog_loop_scalar_sort(CloogLoop *loop, int level, int *scaldims,
+				   int nb_scattdims, int scalar);
+CloogLoop *cloog_loop_scalar_group(CloogLoop **loop, int *scaldims,
+				   int nb_scattdims);
 CloogLoop *cloog_loop_simplify(CloogLoop *loop, CloogDomain *context, int level,
 	int nb_scattdims, CloogOptions *options);
 void cloog_loop_scatter(CloogLoop *, CloogScattering *);
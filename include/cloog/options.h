@@ -52,6 +52,22 @@ extern "C"
 
 struct osl_scop;
 
+/* Strategies CLooG switches to, in that order, each time it has spent
+ * options->max_operations isl operations on code generation.
+ */
+enum cloog_fallback {
+  CLOOG_FALLBACK_NONE,    /* Generated with the options of the user. */
+  CLOOG_FALLBACK_SIMPLE,  /* Simple hulls and no backtracking. */
+  CLOOG_FALLBACK_MERGE    /* No separation and no backtracking. */
+};
+
+/* Metrics cloog_program_tune minimizes over its configurations. */
+enum cloog_tune_metric {
+  CLOOG_TUNE_NONE,        /* No tuning, use the options of the user. */
+  CLOOG_TUNE_NODES,       /* Number of nodes of the clast. */
+  CLOOG_TUNE_GUARDS       /* Number of conditions in guards of the clast. */
+};
+
 struct cloogoptions;
 typedef struct cloogoptions CloogOptions;
 struct osl_scop;
@@ -72,6 +88,46 @@ struct cloogoptions
                      */
   int sh;	    /* 1 for computing simple hulls */
   int first_unroll; /* The first dimension to unroll */
+  int unroll_depth; /* Scattering dimension to unroll partially (-1: none). */
+  int unroll_factor; /* Number of iterations per iteration of the partially
+                      * unrolled loops.
+                      */
+  int *unroll_factors; /* Partial unroll factor (statement-wise). */
+  int unroll_factors_size; /* Size of the unroll_factors array. */
+  int full_tiles;   /* Depth of the innermost tile loops, the loops of which
+                     * are split into full and partial tiles (-1: none).
+                     */
+  int threads;      /* Number of threads used to generate independent
+                     * components of the loop nest (1: no threads).
+                     */
+  int threads_depth; /* Last depth at which the inner loops of sibling
+                       * loops are generated in parallel (-1: infinity).
+                       */
+  int separate_budget; /* Maximum number of polyhedra when separating the
+                        * loops of one level before falling back to merging
+                        * them (-1: infinity).
+                        */
+  int size_budget;  /* Maximum average number of copies of each loop when
+                     * separating the loops of one level, the choice between
+                     * separation and merging being automatic at each level
+                     * (-1: no automatic choice, use f and l).
+                     */
+  int max_operations; /* Maximum number of isl operations for generating
+                       * the loops before falling back to the next cheaper
+                       * strategy, counted again from zero after each
+                       * fallback (-1: infinity).
+                       */
+  int hoist;        /* 1 to hoist the guards of inner loops into the outer
+                     * loops instead of backtracking, 0 otherwise.
+                     */
+  int tune;         /* Metric to minimize by trying several configurations
+                     * of the options above (one of enum cloog_tune_metric).
+                     */
+  struct cloogdomain **versions; /* Parameter domains for which a specialised
+                                  * version of the code is generated, in
+                                  * order of preference (owned by the options).
+                                  */
+  int nb_versions;  /* Size of the versions array. */
 
   /* OPTIONS FOR PRETTY PRINTING */
   int esp ;       /* 1 if user wants to spread all equalities, i.e. when there
@@ -101,12 +157,19 @@ struct cloogoptions
   /* MISC OPTIONS */
   char * name ;   /* Name of the input file. */
   float time ;    /* Time spent for code generation in seconds. */
+  int fallback;   /* Cheaper strategy used to stay within max_operations
+                   * (one of enum cloog_fallback).
+                   */
   int openscop;   /* 1 if the input file has OpenScop format, 0 otherwise. */
   struct osl_scop *scop; /* Input OpenScop scop if any, NULL otherwise. */
 #ifdef CLOOG_MEMORY
   int memory ;    /* Memory spent for code generation in kilobytes. */
 #endif
   int quiet;      /* Don't print any informational messages. */
+  int stream;     /* 1 to generate and print the code of each group of
+                   * statements with the same leading scalar dimensions
+                   * in turn, 0 to generate all the code first.
+                   */
   /* UNDOCUMENTED OPTIONS FOR THE AUTHOR ONLY */
   int leaks ;     /* 1 if I want to print the allocation statistics,
                    * 0 otherwise.
@@ -102,6 +102,8 @@ CloogProgram * cloog_program_malloc(void);
 CloogProgram * cloog_program_alloc(CloogDomain *context, CloogUnionDomain *ud,
 	CloogOptions *options);
 CloogProgram * cloog_program_generate(CloogProgram *, CloogOptions *) ;
+void cloog_program_stream(FILE *, CloogProgram *, CloogOptions *);
+int cloog_program_tune(CloogProgram *, CloogOptions *);
 void cloog_program_block(CloogProgram *program,
 	CloogScatteringList *scattering, CloogOptions *options);
 void cloog_program_extract_scalars(CloogProgram *program,
@@ -4,6 +4,12 @@
 struct cloogbackend;
 typedef struct cloogbackend CloogBackend;
 
+struct cloogarena;
+typedef struct cloogarena CloogArena;
+
+struct cloogcomponents;
+typedef struct cloogcomponents CloogComponents;
+
 #if defined(__cplusplus)
 extern "C" {
 #endif 
@@ -30,6 +36,13 @@ struct cloogstate {
   int statement_allocated;
   int statement_freed;
   int statement_max;
+
+  int memo_size;   /* Maximal number of memoized domain operations. */
+  int memo_hits;
+  int memo_misses;
+
+  CloogArena *arena; /* Memory of the loops, blocks and statements, if any. */
+  CloogComponents *components; /* Components kept between runs, if any. */
 };
 typedef struct cloogstate CloogState;
 
@@ -39,6 +52,14 @@ CloogState *cloog_state_malloc(void);
 void cloog_core_state_free(CloogState *state);
 void cloog_state_free(CloogState *state);
 
+void cloog_state_use_arena(CloogState *state);
+void cloog_state_reuse_components(CloogState *state);
+void *cloog_state_node_alloc(CloogState *state, size_t size);
+void cloog_state_node_free(CloogState *state, void *node, size_t size);
+
+void cloog_state_set_max_operations(CloogState *state, int max);
+int cloog_state_max_operations_exceeded(CloogState *state);
+
 #if defined(__cplusplus)
 }
 #endif 
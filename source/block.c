@@ -212,7 +212,7 @@ void cloog_block_free(CloogBlock * block)
       }
       if (block->statement)
 	cloog_statement_free(block->statement);
-      free(block) ;
+      cloog_state_node_free(block->state, block, sizeof(CloogBlock));
     }
   }
 }
@@ -250,9 +250,7 @@ CloogBlock *cloog_block_malloc(CloogState *state)
 { CloogBlock * block ;
   
   /* Memory allocation for the CloogBlock structure. */
-  block = (CloogBlock *)malloc(sizeof(CloogBlock)) ;
-  if (block == NULL) 
-    cloog_die("memory overflow.\n");
+  block = (CloogBlock *)cloog_state_node_alloc(state, sizeof(CloogBlock));
   cloog_block_leak_up(state);
   
   /* We set the various fields with default values. */
@@ -56,10 +56,14 @@ int main(int argv, char * argc[])
   fclose(input) ;
   
   /* Generating and printing the code. */
-  program = cloog_program_generate(program,options) ;
-  if (options->structure)
-  cloog_program_print(stdout,program) ;
-  cloog_program_pprint(output,program,options) ;
+  if (options->stream)
+    cloog_program_stream(output, program, options);
+  else {
+    program = cloog_program_generate(program,options) ;
+    if (options->structure)
+    cloog_program_print(stdout,program) ;
+    cloog_program_pprint(output,program,options) ;
+  }
   cloog_program_free(program) ;
 
   /* Printing the allocation statistics if asked. */
@@ -72,6 +76,9 @@ int main(int argv, char * argc[])
            state->statement_allocated, state->statement_freed, state->statement_max);
     fprintf(output,"/* Blocks     : allocated=%5d, freed=%5d, max=%5d. */\n",
            state->block_allocated, state->block_freed, state->block_max);
+    if (state->memo_size > 0)
+      fprintf(output,"/* Memo       : hits=%5d, misses=%5d. */\n",
+             state->memo_hits, state->memo_misses);
   }
 
   /* Inform the user in case of a problem with the allocation statistics. */
@@ -1,4 +1,6 @@
 #include <cloog/isl/cloog.h>
+#include <isl/options.h>
+#include <isl/space.h>
 
 /**
  * Allocate and initialize full state.
@@ -22,14 +24,69 @@ CloogState *cloog_isl_state_malloc(struct isl_ctx *ctx)
 	state->backend = isl_alloc_type(ctx, CloogBackend);
 	state->backend->ctx = ctx;
 	state->backend->ctx_allocated = allocated;
+	state->backend->max_operations = -1;
+	state->backend->projections = NULL;
+	state->backend->interned = NULL;
+	state->backend->memo = NULL;
+	state->backend->follows = NULL;
+	state->backend->facts = NULL;
 	return state;
 }
 
+/**
+ * Start counting the isl operations performed on behalf of "state",
+ * against a budget of "max" operations per period (-1: no budget).
+ */
+void cloog_state_set_max_operations(CloogState *state, int max)
+{
+	state->backend->max_operations = max;
+	isl_ctx_reset_operations(state->backend->ctx);
+}
+
+/**
+ * Check whether the budget of the current period has been spent and,
+ * if so, start a new period.  The isl context only enforces the budget
+ * during this check, such that isl operations never fail halfway
+ * through code generation.  Since isl counts its memory allocations
+ * as operations, allocating a space is enough to find out whether
+ * the budget is exceeded: the allocation then fails with a quota error.
+ */
+int cloog_state_max_operations_exceeded(CloogState *state)
+{
+	isl_ctx *ctx = state->backend->ctx;
+	int max = state->backend->max_operations;
+	int on_error, exceeded;
+
+	if (max < 0)
+		return 0;
+
+	on_error = isl_options_get_on_error(ctx);
+	isl_options_set_on_error(ctx, ISL_ON_ERROR_CONTINUE);
+	isl_ctx_set_max_operations(ctx, max > 0 ? max : 1);
+	isl_space_free(isl_space_set_alloc(ctx, 0, 0));
+	exceeded = isl_ctx_last_error(ctx) == isl_error_quota;
+	isl_ctx_set_max_operations(ctx, 0);
+	isl_options_set_on_error(ctx, on_error);
+
+	if (exceeded) {
+		isl_ctx_reset_error(ctx);
+		isl_ctx_reset_operations(ctx);
+	}
+	return exceeded;
+}
+
+
 /**
  * Free state and backend independent parts.
  */
 void cloog_state_free(CloogState *state)
 {
+	cloog_loop_components_free(state->components);
+	cloog_domain_table_free(state->backend->projections);
+	cloog_domain_table_free(state->backend->interned);
+	cloog_domain_table_free(state->backend->memo);
+	cloog_domain_table_free(state->backend->follows);
+	cloog_domain_facts_free(state->backend->facts);
 	if (state->backend->ctx_allocated)
 		isl_ctx_free(state->backend->ctx);
 	free(state->backend);
@@ -127,6 +127,44 @@ CloogDomain * cloog_domain_copy(CloogDomain * domain)
 }
 
 
+/**
+ * cloog_domain_transfer function:
+ * Returns a copy of domain that lives in the isl_ctx of state.
+ * isl objects cannot be shared between different isl_ctx objects,
+ * so the set is printed and parsed back in the other context.
+ * The parser assigns names to unnamed dimensions, so the names of
+ * the original set are restored afterwards.
+ */
+CloogDomain *cloog_domain_transfer(CloogDomain *domain, CloogState *state)
+{
+	int i;
+	char *str;
+	isl_printer *p;
+	isl_set *copy;
+	isl_set *set = isl_set_from_cloog_domain(domain);
+
+	if (!set)
+		return NULL;
+
+	p = isl_printer_to_str(isl_set_get_ctx(set));
+	p = isl_printer_print_set(p, set);
+	str = isl_printer_get_str(p);
+	isl_printer_free(p);
+	copy = isl_set_read_from_str(state->backend->ctx, str);
+	free(str);
+
+	for (i = 0; i < isl_set_dim(set, isl_dim_param); ++i)
+		copy = isl_set_set_dim_name(copy, isl_dim_param, i,
+				isl_set_get_dim_name(set, isl_dim_param, i));
+	for (i = 0; i < isl_set_dim(set, isl_dim_set); ++i)
+		copy = isl_set_set_dim_name(copy, isl_dim_set, i,
+				isl_set_get_dim_name(set, isl_dim_set, i));
+	copy = isl_set_set_tuple_name(copy, isl_set_get_tuple_name(set));
+
+	return cloog_domain_from_isl_set(copy);
+}
+
+
 /**
  * cloog_domain_convex function:
  * Computes the convex hull of domain.
@@ -134,8 +172,8 @@ CloogDomain * cloog_domain_copy(CloogDomain * domain)
 CloogDomain *cloog_domain_convex(CloogDomain *domain)
 {
 	isl_set *set = isl_set_from_cloog_domain(domain);
-  set = isl_set_coalesce(set);
-	set = isl_set_from_basic_set(isl_set_convex_hull(isl_set_copy(set)));
+	set = isl_set_coalesce(isl_set_copy(set));
+	set = isl_set_from_basic_set(isl_set_convex_hull(set));
 	return cloog_domain_from_isl_set(set);
 }
 
@@ -221,6 +259,54 @@ CloogDomain *cloog_domain_difference(CloogDomain *domain, CloogDomain *minus)
 }
 
 
+static int cloog_domain_box_compare_at(CloogDomainBox *box1,
+	CloogDomainBox *box2, int pos);
+
+
+/* Rows of bits indexed by domain, used by cloog_domain_sort.
+ */
+#define CLOOG_SORT_BITS		(8 * sizeof(unsigned long))
+#define CLOOG_SORT_WORDS(n)	(((n) + CLOOG_SORT_BITS - 1) / CLOOG_SORT_BITS)
+#define CLOOG_SORT_TEST(row, k)	\
+	(((row)[(k) / CLOOG_SORT_BITS] >> ((k) % CLOOG_SORT_BITS)) & 1)
+#define CLOOG_SORT_SET(row, k)	\
+	((row)[(k) / CLOOG_SORT_BITS] |= 1UL << ((k) % CLOOG_SORT_BITS))
+#define CLOOG_SORT_CLEAR(row, k)	\
+	((row)[(k) / CLOOG_SORT_BITS] &= ~(1UL << ((k) % CLOOG_SORT_BITS)))
+
+/* Record that domain "i" follows domain "j" in both "follows",
+ * where row i has a bit for every domain that i follows,
+ * and "precedes", where row j has a bit for every domain that follows j.
+ */
+static void cloog_domain_sort_add(unsigned long **follows,
+	unsigned long **precedes, int i, int j)
+{
+	CLOOG_SORT_SET(follows[i], j);
+	CLOOG_SORT_SET(precedes[j], i);
+}
+
+/* Return the first bit set in "row" at or after position "start",
+ * wrapping around at "n", or -1 if there is no bit set in "row".
+ */
+static int cloog_domain_sort_next(unsigned long *row, int n, int start)
+{
+	int k, w, words = CLOOG_SORT_WORDS(n);
+	int first = start / CLOOG_SORT_BITS;
+	unsigned long word;
+
+	for (w = first; w <= first + words; ++w) {
+		word = row[w % words];
+		if (w == first)
+			word &= ~0UL << (start % CLOOG_SORT_BITS);
+		if (!word)
+			continue;
+		for (k = 0; !((word >> k) & 1); ++k)
+			;
+		return (w % words) * CLOOG_SORT_BITS + k;
+	}
+	return -1;
+}
+
 /**
  * cloog_domain_sort function:
  * This function topologically sorts (nb_doms) domains. Here (doms) is an
@@ -229,13 +315,21 @@ CloogDomain *cloog_domain_difference(CloogDomain *domain, CloogDomain *minus)
  * parameter space dimension, (permut) if not NULL, is an array of (nb_doms)
  * integers that contains a permutation specification after call in order to
  * apply the topological sorting. 
+ * The relation between the domains is kept as rows of bits, in both
+ * directions, such that the pairs that follow by transitivity from
+ * a comparison are updated a word at a time, and the order is extracted
+ * by removing the domains whose predecessors have all been placed.
+ * Whenever several domains can be placed, the first one after the last
+ * placed domain (cyclically) is chosen.
  */
 void cloog_domain_sort(CloogDomain **doms, unsigned nb_doms, unsigned level,
 			int *permut)
 {
-	int i, j, k, cmp;
+	int i, j, k, w, words, cmp;
 	struct isl_ctx *ctx;
-	unsigned char **follows;
+	unsigned long **follows, **precedes, *bits, *ready;
+	int *n_pred;
+	CloogDomainBox **box;
 	isl_set *set_i, *set_j;
 	isl_basic_set *bset_i, *bset_j;
 	isl_basic_set_list *list_i, *list_j;
@@ -249,18 +343,35 @@ void cloog_domain_sort(CloogDomain **doms, unsigned nb_doms, unsigned level,
 		assert(isl_set_n_basic_set(set_i) == 1);
 	}
 
-	follows = isl_alloc_array(ctx, unsigned char *, nb_doms);
-	assert(follows);
-	for (i = 0; i < nb_doms; ++i) {
-		follows[i] = isl_alloc_array(ctx, unsigned char, nb_doms);
-		assert(follows[i]);
-		for (j = 0; j < nb_doms; ++j)
-			follows[i][j] = 0;
-	}
+	/* The boxes rule out many pairs without solving any LP. */
+	box = isl_alloc_array(ctx, CloogDomainBox *, nb_doms);
+	assert(box);
+	for (i = 0; i < nb_doms; ++i)
+		box[i] = cloog_domain_box(doms[i]);
+
+	words = CLOOG_SORT_WORDS(nb_doms);
+	bits = isl_calloc_array(ctx, unsigned long, (2 * nb_doms + 1) * words);
+	follows = isl_alloc_array(ctx, unsigned long *, 2 * nb_doms);
+	assert(bits && follows);
+	precedes = follows + nb_doms;
+	for (i = 0; i < 2 * nb_doms; ++i)
+		follows[i] = bits + i * words;
+	ready = bits + 2 * nb_doms * words;
 
 	for (i = 1; i < nb_doms; ++i) {
 		for (j = 0; j < i; ++j) {
-			if (follows[i][j] || follows[j][i])
+			if (CLOOG_SORT_TEST(follows[i], j) ||
+			    CLOOG_SORT_TEST(follows[j], i))
+				continue;
+			/* Domains that are apart in an outer dimension have
+			 * no common values there, so that the comparison
+			 * below would be 0 without solving its LP.
+			 */
+			for (k = 0; k + 1 < level; ++k)
+				if (cloog_domain_box_compare_at(box[i], box[j],
+								k))
+					break;
+			if (k + 1 < level)
 				continue;
 			set_i = isl_set_from_cloog_domain(doms[i]);
 			set_j = isl_set_from_cloog_domain(doms[j]);
@@ -275,34 +386,70 @@ void cloog_domain_sort(CloogDomain **doms, unsigned nb_doms, unsigned level,
 			isl_basic_set_free(bset_j);
 			if (!cmp)
 				continue;
+			/* Only the domains before i are related so far,
+			 * so that the rows and columns of j only hold
+			 * domains before i.
+			 */
 			if (cmp > 0) {
-				follows[i][j] = 1;
-				for (k = 0; k < i; ++k)
-					follows[i][k] |= follows[j][k];
+				cloog_domain_sort_add(follows, precedes, i, j);
+				for (w = 0; w < words; ++w) {
+					unsigned long add;
+					add = follows[j][w] & ~follows[i][w];
+					for (k = w * CLOOG_SORT_BITS; add;
+					     ++k, add >>= 1)
+						if (add & 1)
+							cloog_domain_sort_add(
+							    follows, precedes,
+							    i, k);
+				}
 			} else {
-				follows[j][i] = 1;
-				for (k = 0; k < i; ++k)
-					follows[k][i] |= follows[k][j];
+				cloog_domain_sort_add(follows, precedes, j, i);
+				for (w = 0; w < words; ++w) {
+					unsigned long add;
+					add = precedes[j][w] & ~precedes[i][w];
+					for (k = w * CLOOG_SORT_BITS; add;
+					     ++k, add >>= 1)
+						if (add & 1)
+							cloog_domain_sort_add(
+							    follows, precedes,
+							    k, i);
+				}
 			}
 		}
 	}
 
-	for (i = 0, j = 0; i < nb_doms; j = (j + 1) % nb_doms) {
-		for (k = 0; k < nb_doms; ++k)
-			if (follows[j][k])
-				break;
-		if (k < nb_doms)
-			continue;
-		for (k = 0; k < nb_doms; ++k)
-			follows[k][j] = 0;
-		follows[j][j] = 1;
+	n_pred = isl_calloc_array(ctx, int, nb_doms);
+	assert(n_pred);
+	for (j = 0; j < nb_doms; ++j) {
+		for (w = 0; w < words; ++w) {
+			unsigned long word;
+			for (word = follows[j][w]; word; word &= word - 1)
+				n_pred[j]++;
+		}
+		if (!n_pred[j])
+			CLOOG_SORT_SET(ready, j);
+	}
+
+	for (i = 0, j = 0; i < nb_doms; ++i) {
+		j = cloog_domain_sort_next(ready, nb_doms, j);
+		assert(j >= 0);
+		CLOOG_SORT_CLEAR(ready, j);
 		permut[i] = 1 + j;
-		++i;
+		for (w = 0; w < words; ++w) {
+			unsigned long word = precedes[j][w];
+			for (k = w * CLOOG_SORT_BITS; word; ++k, word >>= 1)
+				if ((word & 1) && !--n_pred[k])
+					CLOOG_SORT_SET(ready, k);
+		}
+		j = (j + 1) % nb_doms;
 	}
+	free(n_pred);
 
 	for (i = 0; i < nb_doms; ++i)
-		free(follows[i]);
+		cloog_domain_box_free(box[i]);
+	free(follows[0]);
 	free(follows);
+	free(box);
 }
 
 
@@ -756,6 +903,620 @@ CloogDomain *cloog_domain_project(CloogDomain *domain, int level)
 }
 
 
+/* A table of sets (or integers), indexed by one or two sets (the keys)
+ * and an integer.
+ * It holds the projections computed by cloog_domain_project_cached,
+ * indexed by the projected set and the number of kept dimensions,
+ * the domains interned by cloog_domain_intern, indexed by themselves,
+ * the comparisons made by cloog_domain_follows_cached, indexed by
+ * the compared sets and the level,
+ * and the results of the operations memoized by the cloog_domain_*_cached
+ * functions, indexed by their operands and the operation.
+ * A set only matches a key if their basic sets are plainly equal and
+ * appear in the same order, such that a set can be replaced by the
+ * matching one without changing the generated code.
+ * isl_set_plain_is_equal cannot be used here since it normalizes its
+ * arguments in place, reordering the basic sets of the domains of the caller.
+ * When a table is full, its least recently used entry is dropped.
+ */
+#define CLOOG_DOMAIN_TABLE_BUCKETS	1024
+#define CLOOG_DOMAIN_TABLE_MAX		4096
+
+struct cloog_domain_table_entry {
+	unsigned hash;
+	int level;
+	isl_basic_set_list *key;
+	isl_basic_set_list *key2;	/* NULL if there is one key only. */
+	isl_set *set;
+	int value;
+	struct cloog_domain_table_entry *next;	/* In the same bucket. */
+	struct cloog_domain_table_entry *newer;
+	struct cloog_domain_table_entry *older;
+};
+
+struct cloog_domain_table {
+	int n;
+	struct cloog_domain_table_entry *newest;
+	struct cloog_domain_table_entry *oldest;
+	struct cloog_domain_table_entry *bucket[CLOOG_DOMAIN_TABLE_BUCKETS];
+};
+
+static void cloog_domain_table_entry_free(struct cloog_domain_table_entry *e)
+{
+	isl_basic_set_list_free(e->key);
+	isl_basic_set_list_free(e->key2);
+	isl_set_free(e->set);
+	free(e);
+}
+
+void cloog_domain_table_free(struct cloog_domain_table *table)
+{
+	struct cloog_domain_table_entry *e, *next;
+
+	if (!table)
+		return;
+	for (e = table->newest; e; e = next) {
+		next = e->older;
+		cloog_domain_table_entry_free(e);
+	}
+	free(table);
+}
+
+/* Return the table pointed to by "table", allocating it if needed.
+ */
+static struct cloog_domain_table *cloog_domain_table_get(
+	struct cloog_domain_table **table)
+{
+	if (!*table) {
+		*table = (struct cloog_domain_table *)
+			calloc(1, sizeof(struct cloog_domain_table));
+		if (!*table)
+			cloog_die("memory overflow.\n");
+	}
+	return *table;
+}
+
+/* Return a hash of the basic sets in "list" (in order) and of "level",
+ * based only on their sizes.
+ */
+static unsigned cloog_domain_table_hash(isl_basic_set_list *list, int level)
+{
+	int i, n;
+	unsigned hash = level;
+
+	n = isl_basic_set_list_n_basic_set(list);
+	for (i = 0; i < n; ++i) {
+		isl_basic_set *bset = isl_basic_set_list_get_basic_set(list, i);
+		hash = 31 * hash + isl_basic_set_n_constraint(bset);
+		hash = 31 * hash + isl_basic_set_dim(bset, isl_dim_div);
+		isl_basic_set_free(bset);
+	}
+	return 31 * hash + n;
+}
+
+/* Are the basic sets in "list1" and "list2" plainly equal,
+ * pairwise and in order?
+ */
+static int cloog_domain_table_equal(isl_basic_set_list *list1,
+	isl_basic_set_list *list2)
+{
+	int i, n, equal = 1;
+
+	if (!list1 || !list2)
+		return list1 == list2;
+	n = isl_basic_set_list_n_basic_set(list1);
+	if (isl_basic_set_list_n_basic_set(list2) != n)
+		return 0;
+	for (i = 0; equal && i < n; ++i) {
+		isl_basic_set *bset1 = isl_basic_set_list_get_basic_set(list1, i);
+		isl_basic_set *bset2 = isl_basic_set_list_get_basic_set(list2, i);
+		equal = isl_basic_set_plain_is_equal(bset1, bset2) == isl_bool_true;
+		isl_basic_set_free(bset1);
+		isl_basic_set_free(bset2);
+	}
+	return equal;
+}
+
+/* Remove "e" from the list of entries of "table" ordered by their last use.
+ */
+static void cloog_domain_table_unlink(struct cloog_domain_table *table,
+	struct cloog_domain_table_entry *e)
+{
+	if (e->newer)
+		e->newer->older = e->older;
+	else
+		table->newest = e->older;
+	if (e->older)
+		e->older->newer = e->newer;
+	else
+		table->oldest = e->newer;
+}
+
+/* Make "e" the most recently used entry of "table".
+ */
+static void cloog_domain_table_touch(struct cloog_domain_table *table,
+	struct cloog_domain_table_entry *e)
+{
+	e->newer = NULL;
+	e->older = table->newest;
+	if (table->newest)
+		table->newest->newer = e;
+	else
+		table->oldest = e;
+	table->newest = e;
+}
+
+/* Drop the least recently used entry of "table".
+ */
+static void cloog_domain_table_drop_oldest(struct cloog_domain_table *table)
+{
+	struct cloog_domain_table_entry *e = table->oldest, **p;
+
+	cloog_domain_table_unlink(table, e);
+	p = &table->bucket[e->hash % CLOOG_DOMAIN_TABLE_BUCKETS];
+	while (*p != e)
+		p = &(*p)->next;
+	*p = e->next;
+	cloog_domain_table_entry_free(e);
+	table->n--;
+}
+
+/* Look for an entry matching "key", "key2" (with the given "hash")
+ * and "level" in "table" and return a pointer to it,
+ * or NULL if there is none.
+ */
+static struct cloog_domain_table_entry *cloog_domain_table_find(
+	struct cloog_domain_table *table, isl_basic_set_list *key,
+	isl_basic_set_list *key2, unsigned hash, int level)
+{
+	struct cloog_domain_table_entry *e;
+
+	e = table->bucket[hash % CLOOG_DOMAIN_TABLE_BUCKETS];
+	for (; e; e = e->next)
+		if (e->hash == hash && e->level == level &&
+		    cloog_domain_table_equal(e->key, key) &&
+		    cloog_domain_table_equal(e->key2, key2))
+			break;
+	if (e && e != table->newest) {
+		cloog_domain_table_unlink(table, e);
+		cloog_domain_table_touch(table, e);
+	}
+	return e;
+}
+
+/* Add an entry mapping "key", "key2" (with the given "hash") and "level"
+ * to "set" and "value" in "table", taking ownership of "key", "key2"
+ * and "set".  The table keeps at most "max" entries.
+ */
+static void cloog_domain_table_add(struct cloog_domain_table *table, int max,
+	isl_basic_set_list *key, isl_basic_set_list *key2, unsigned hash,
+	int level, isl_set *set, int value)
+{
+	struct cloog_domain_table_entry *e, **bucket;
+
+	while (table->n > 0 && table->n >= max)
+		cloog_domain_table_drop_oldest(table);
+	e = (struct cloog_domain_table_entry *)
+		malloc(sizeof(struct cloog_domain_table_entry));
+	if (!e)
+		cloog_die("memory overflow.\n");
+	bucket = &table->bucket[hash % CLOOG_DOMAIN_TABLE_BUCKETS];
+	e->hash = hash;
+	e->level = level;
+	e->key = key;
+	e->key2 = key2;
+	e->set = set;
+	e->value = value;
+	e->next = *bucket;
+	*bucket = e;
+	cloog_domain_table_touch(table, e);
+	table->n++;
+}
+
+/**
+ * cloog_domain_project_cached function:
+ * This function returns the same projection as cloog_domain_project,
+ * but remembers it within (state), such that the projection of a domain
+ * that is identical to one that has already been projected on the same
+ * dimensions is not computed again.
+ */
+CloogDomain *cloog_domain_project_cached(CloogState *state,
+	CloogDomain *domain, int level)
+{
+	isl_set *set = isl_set_from_cloog_domain(domain);
+	struct cloog_domain_table *table;
+	struct cloog_domain_table_entry *e;
+	isl_basic_set_list *key;
+	CloogDomain *proj;
+	unsigned hash;
+
+	table = cloog_domain_table_get(&state->backend->projections);
+	key = isl_set_get_basic_set_list(set);
+	hash = cloog_domain_table_hash(key, level);
+	e = cloog_domain_table_find(table, key, NULL, hash, level);
+	if (e) {
+		isl_basic_set_list_free(key);
+		return cloog_domain_from_isl_set(isl_set_copy(e->set));
+	}
+
+	proj = cloog_domain_project(domain, level);
+	cloog_domain_table_add(table, CLOOG_DOMAIN_TABLE_MAX, key, NULL, hash,
+		level, isl_set_copy(isl_set_from_cloog_domain(proj)), 0);
+
+	return proj;
+}
+
+
+/**
+ * cloog_domain_intern function:
+ * This function returns a domain that is identical to (domain), sharing
+ * it with all the other domains that have been interned within (state)
+ * and that are identical to (domain).  Identical domains that have been
+ * interned are therefore the same object and cloog_domain_lazy_equal
+ * recognizes them without looking at their constraints.
+ * The input domain is consumed.
+ */
+CloogDomain *cloog_domain_intern(CloogState *state, CloogDomain *domain)
+{
+	isl_set *set = isl_set_from_cloog_domain(domain);
+	struct cloog_domain_table *table;
+	struct cloog_domain_table_entry *e;
+	isl_basic_set_list *key;
+	unsigned hash;
+
+	table = cloog_domain_table_get(&state->backend->interned);
+	key = isl_set_get_basic_set_list(set);
+	hash = cloog_domain_table_hash(key, 0);
+	e = cloog_domain_table_find(table, key, NULL, hash, 0);
+	if (e) {
+		isl_basic_set_list_free(key);
+		isl_set_free(set);
+		return cloog_domain_from_isl_set(isl_set_copy(e->set));
+	}
+
+	cloog_domain_table_add(table, CLOOG_DOMAIN_TABLE_MAX, key, NULL, hash,
+		0, isl_set_copy(set), 0);
+
+	return domain;
+}
+
+
+/**
+ * cloog_domain_follows_cached function:
+ * This function returns the same result as cloog_domain_follows, but
+ * remembers it within (state), such that the same pair of domains
+ * compared again at the same level, e.g., when the components of the
+ * next level are computed, does not need another LP.
+ * Pairs where every value of (dom1) at the given level is smaller than
+ * every value of (dom2) are recognized from their bounding boxes.
+ */
+int cloog_domain_follows_cached(CloogState *state, CloogDomain *dom1,
+	CloogDomain *dom2, unsigned level)
+{
+	struct cloog_domain_table *table;
+	struct cloog_domain_table_entry *e;
+	isl_basic_set_list *key, *key2;
+	CloogDomainBox *box1, *box2;
+	unsigned hash;
+	int follows;
+
+	table = cloog_domain_table_get(&state->backend->follows);
+	key = isl_set_get_basic_set_list(isl_set_from_cloog_domain(dom1));
+	key2 = isl_set_get_basic_set_list(isl_set_from_cloog_domain(dom2));
+	hash = 31 * cloog_domain_table_hash(key, level) +
+		cloog_domain_table_hash(key2, 0);
+	e = cloog_domain_table_find(table, key, key2, hash, level);
+	if (e) {
+		isl_basic_set_list_free(key);
+		isl_basic_set_list_free(key2);
+		return e->value;
+	}
+
+	box1 = cloog_domain_box(dom1);
+	box2 = cloog_domain_box(dom2);
+	if (cloog_domain_box_compare_at(box1, box2, level - 1) < 0)
+		follows = -1;
+	else
+		follows = cloog_domain_follows(dom1, dom2, level);
+	cloog_domain_box_free(box1);
+	cloog_domain_box_free(box2);
+
+	cloog_domain_table_add(table, CLOOG_DOMAIN_TABLE_MAX, key, key2, hash,
+		level, NULL, follows);
+
+	return follows;
+}
+
+
+/* The operations memoized by the cloog_domain_*_cached functions.
+ */
+enum cloog_domain_memo_op {
+	cloog_domain_memo_intersection,
+	cloog_domain_memo_difference,
+	cloog_domain_memo_simplify,
+	cloog_domain_memo_isempty
+};
+
+/* A memoized operation, with its operands and their keys.
+ */
+struct cloog_domain_memo {
+	struct cloog_domain_table *table;
+	isl_basic_set_list *key;
+	isl_basic_set_list *key2;
+	unsigned hash;
+};
+
+/* Look up the result of applying "op" to "dom1" and "dom2" (if not NULL)
+ * in the memo cache of "state", counting the hit or the miss.
+ * Return the matching entry, if any.  Otherwise, fill in "memo" such that
+ * the result can be added by cloog_domain_memo_add.
+ */
+static struct cloog_domain_table_entry *cloog_domain_memo_find(
+	CloogState *state, enum cloog_domain_memo_op op,
+	CloogDomain *dom1, CloogDomain *dom2, struct cloog_domain_memo *memo)
+{
+	struct cloog_domain_table_entry *e;
+
+	memo->table = cloog_domain_table_get(&state->backend->memo);
+	memo->key = isl_set_get_basic_set_list(isl_set_from_cloog_domain(dom1));
+	memo->key2 = NULL;
+	memo->hash = cloog_domain_table_hash(memo->key, op);
+	if (dom2) {
+		memo->key2 = isl_set_get_basic_set_list(
+					isl_set_from_cloog_domain(dom2));
+		memo->hash = 31 * memo->hash +
+				cloog_domain_table_hash(memo->key2, 0);
+	}
+	e = cloog_domain_table_find(memo->table, memo->key, memo->key2,
+				    memo->hash, op);
+	if (!e) {
+		state->memo_misses++;
+		return NULL;
+	}
+	state->memo_hits++;
+	isl_basic_set_list_free(memo->key);
+	isl_basic_set_list_free(memo->key2);
+	return e;
+}
+
+/* Remember that applying "op" to the operands in "memo" results
+ * in "domain" or "value".
+ */
+static void cloog_domain_memo_add(CloogState *state,
+	enum cloog_domain_memo_op op, struct cloog_domain_memo *memo,
+	CloogDomain *domain, int value)
+{
+	isl_set *set = domain ? isl_set_from_cloog_domain(domain) : NULL;
+
+	cloog_domain_table_add(memo->table, state->memo_size,
+		memo->key, memo->key2, memo->hash, op, isl_set_copy(set), value);
+}
+
+/* Apply the set operation "op", computed by "fn", to "dom1" and "dom2",
+ * using the memo cache of "state" if it is enabled.
+ */
+static CloogDomain *cloog_domain_memo_apply(CloogState *state,
+	enum cloog_domain_memo_op op,
+	CloogDomain *(*fn)(CloogDomain *, CloogDomain *),
+	CloogDomain *dom1, CloogDomain *dom2)
+{
+	struct cloog_domain_memo memo;
+	struct cloog_domain_table_entry *e;
+	CloogDomain *res;
+
+	if (state->memo_size <= 0)
+		return fn(dom1, dom2);
+
+	e = cloog_domain_memo_find(state, op, dom1, dom2, &memo);
+	if (e)
+		return cloog_domain_from_isl_set(isl_set_copy(e->set));
+	res = fn(dom1, dom2);
+	cloog_domain_memo_add(state, op, &memo, res, 0);
+	return res;
+}
+
+/**
+ * cloog_domain_intersection_cached, cloog_domain_difference_cached and
+ * cloog_domain_simplify_cached functions:
+ * These functions return the same results as the corresponding functions
+ * without suffix.  If state->memo_size is positive, they remember up to
+ * that many results within (state), such that an operation applied again
+ * to identical operands is not computed again.
+ */
+CloogDomain *cloog_domain_intersection_cached(CloogState *state,
+	CloogDomain *dom1, CloogDomain *dom2)
+{
+	return cloog_domain_memo_apply(state, cloog_domain_memo_intersection,
+				&cloog_domain_intersection, dom1, dom2);
+}
+
+CloogDomain *cloog_domain_difference_cached(CloogState *state,
+	CloogDomain *domain, CloogDomain *minus)
+{
+	return cloog_domain_memo_apply(state, cloog_domain_memo_difference,
+				&cloog_domain_difference, domain, minus);
+}
+
+CloogDomain *cloog_domain_simplify_cached(CloogState *state,
+	CloogDomain *dom1, CloogDomain *dom2)
+{
+	return cloog_domain_memo_apply(state, cloog_domain_memo_simplify,
+				&cloog_domain_simplify, dom1, dom2);
+}
+
+/* The facts about domains remembered by the cloog_domain_*_cached
+ * query functions.  Each entry keeps a reference to its domain,
+ * such that the domain cannot be modified in place (isl copies a set
+ * before modifying it if it has other references) nor be freed
+ * and replaced by another one at the same address while its facts
+ * are remembered.  The entry of a domain is chosen from its address
+ * and is simply taken over by the next domain that needs it.
+ * The "known" bits of an entry tell which facts have been computed
+ * and the corresponding "value" bits hold those facts.
+ * Boundedness is only remembered for the first CLOOG_FACT_LEVELS levels.
+ * Since cloog_domain_never_integral is an exact emptiness test,
+ * both facts are always remembered together (CLOOG_FACT_EMPTINESS).
+ */
+#define CLOOG_DOMAIN_FACTS_SIZE	256
+#define CLOOG_FACT_EMPTY		(1u << 0)
+#define CLOOG_FACT_NEVER_INTEGRAL	(1u << 1)
+#define CLOOG_FACT_EMPTINESS	(CLOOG_FACT_EMPTY | CLOOG_FACT_NEVER_INTEGRAL)
+#define CLOOG_FACT_BOUNDED(level)	(1u << (1 + (level)))
+#define CLOOG_FACT_LEVELS		30
+
+struct cloog_domain_facts_entry {
+	isl_set *set;
+	unsigned known;
+	unsigned value;
+};
+
+struct cloog_domain_facts {
+	struct cloog_domain_facts_entry entry[CLOOG_DOMAIN_FACTS_SIZE];
+};
+
+void cloog_domain_facts_free(struct cloog_domain_facts *facts)
+{
+	int i;
+
+	if (!facts)
+		return;
+	for (i = 0; i < CLOOG_DOMAIN_FACTS_SIZE; ++i)
+		isl_set_free(facts->entry[i].set);
+	free(facts);
+}
+
+/* Return the entry for "domain" in the facts of "state".
+ * The entry may still hold the facts of another domain.
+ */
+static struct cloog_domain_facts_entry *cloog_domain_facts_get(
+	CloogState *state, CloogDomain *domain)
+{
+	struct cloog_domain_facts *facts = state->backend->facts;
+	size_t h = (size_t) domain;
+
+	if (!facts) {
+		facts = (struct cloog_domain_facts *)
+			calloc(1, sizeof(struct cloog_domain_facts));
+		if (!facts)
+			cloog_die("memory overflow.\n");
+		state->backend->facts = facts;
+	}
+	h ^= h >> 12;
+	return &facts->entry[(h >> 4) % CLOOG_DOMAIN_FACTS_SIZE];
+}
+
+/* Is "fact" known about "domain" in entry "f"?
+ */
+static int cloog_domain_fact_known(struct cloog_domain_facts_entry *f,
+	CloogDomain *domain, unsigned fact)
+{
+	return f->set == isl_set_from_cloog_domain(domain) && (f->known & fact);
+}
+
+/* Remember in entry "f" that "fact" holds for "domain" if "value"
+ * is positive and that it does not hold if "value" is zero.
+ */
+static void cloog_domain_fact_set(struct cloog_domain_facts_entry *f,
+	CloogDomain *domain, unsigned fact, int value)
+{
+	isl_set *set = isl_set_from_cloog_domain(domain);
+
+	if (value < 0)
+		return;
+	if (f->set != set) {
+		isl_set_free(f->set);
+		f->set = isl_set_copy(set);
+		f->known = f->value = 0;
+	}
+	f->known |= fact;
+	if (value)
+		f->value |= fact;
+}
+
+/**
+ * cloog_domain_isempty_cached, cloog_domain_never_integral_cached and
+ * cloog_domain_is_bounded_cached functions:
+ * These functions return the same results as the corresponding functions
+ * without suffix, but remember them within (state), such that asking
+ * the same question again about the same domain costs nothing.
+ * Emptiness is also memoized for identical domains if state->memo_size
+ * is positive.
+ */
+int cloog_domain_isempty_cached(CloogState *state, CloogDomain *domain)
+{
+	struct cloog_domain_memo memo;
+	struct cloog_domain_table_entry *e;
+	struct cloog_domain_facts_entry *f;
+	int empty;
+
+	f = cloog_domain_facts_get(state, domain);
+	if (cloog_domain_fact_known(f, domain, CLOOG_FACT_EMPTY))
+		return (f->value & CLOOG_FACT_EMPTY) != 0;
+
+	if (state->memo_size <= 0)
+		empty = cloog_domain_isempty(domain);
+	else {
+		e = cloog_domain_memo_find(state, cloog_domain_memo_isempty,
+					   domain, NULL, &memo);
+		if (e)
+			empty = e->value;
+		else {
+			empty = cloog_domain_isempty(domain);
+			cloog_domain_memo_add(state, cloog_domain_memo_isempty,
+					      &memo, NULL, empty);
+		}
+	}
+	cloog_domain_fact_set(f, domain, CLOOG_FACT_EMPTINESS, empty);
+	return empty;
+}
+
+int cloog_domain_never_integral_cached(CloogState *state, CloogDomain *domain)
+{
+	struct cloog_domain_facts_entry *f;
+	int never;
+
+	f = cloog_domain_facts_get(state, domain);
+	if (cloog_domain_fact_known(f, domain, CLOOG_FACT_NEVER_INTEGRAL))
+		return (f->value & CLOOG_FACT_NEVER_INTEGRAL) != 0;
+	never = cloog_domain_never_integral(domain);
+	cloog_domain_fact_set(f, domain, CLOOG_FACT_EMPTINESS, never);
+	return never;
+}
+
+/**
+ * cloog_domain_lazy_never_integral function:
+ * Returns 1 if (domain) is known to contain no integral point without
+ * performing an emptiness test, i.e., if it is plainly empty or if it has
+ * been found empty before within (state), 0 otherwise.
+ */
+int cloog_domain_lazy_never_integral(CloogState *state, CloogDomain *domain)
+{
+	struct cloog_domain_facts_entry *f;
+
+	if (isl_set_plain_is_empty(isl_set_from_cloog_domain(domain)) > 0)
+		return 1;
+	f = cloog_domain_facts_get(state, domain);
+	return cloog_domain_fact_known(f, domain, CLOOG_FACT_NEVER_INTEGRAL) &&
+		(f->value & CLOOG_FACT_NEVER_INTEGRAL);
+}
+
+int cloog_domain_is_bounded_cached(CloogState *state, CloogDomain *domain,
+	unsigned level)
+{
+	struct cloog_domain_facts_entry *f;
+	int bounded;
+
+	if (level > CLOOG_FACT_LEVELS)
+		return cloog_domain_is_bounded(domain, level);
+	f = cloog_domain_facts_get(state, domain);
+	if (cloog_domain_fact_known(f, domain, CLOOG_FACT_BOUNDED(level)))
+		return (f->value & CLOOG_FACT_BOUNDED(level)) != 0;
+	bounded = cloog_domain_is_bounded(domain, level);
+	cloog_domain_fact_set(f, domain, CLOOG_FACT_BOUNDED(level), bounded);
+	return bounded;
+}
+
+
 /**
  * cloog_domain_extend function:
  * This function returns the (domain) given as input with (dim)
@@ -1139,9 +1900,31 @@ int cloog_domain_lazy_equal(CloogDomain *d1, CloogDomain *d2)
 {
 	isl_set *set1 = isl_set_from_cloog_domain(d1);
 	isl_set *set2 = isl_set_from_cloog_domain(d2);
+	if (set1 == set2)
+		return 1;
 	return isl_set_plain_is_equal(set1, set2);
 }
 
+/**
+ * cloog_domain_to_str function:
+ * Returns a newly allocated string that describes (domain) in its current
+ * representation, i.e., the string is different for different orders
+ * of the same basic sets.
+ */
+char *cloog_domain_to_str(CloogDomain *domain)
+{
+	char *str;
+	isl_printer *p;
+	isl_set *set = isl_set_from_cloog_domain(domain);
+
+	p = isl_printer_to_str(isl_set_get_ctx(set));
+	p = isl_printer_print_set(p, set);
+	str = isl_printer_get_str(p);
+	isl_printer_free(p);
+
+	return str;
+}
+
 struct cloog_bound_split {
 	isl_set *set;
 	int level;
@@ -1217,6 +2000,79 @@ CloogDomain *cloog_domain_bound_splitter(CloogDomain *dom, int level)
 	return cloog_domain_from_isl_set(cbs.set);
 }
 
+struct cloog_tile_bounds {
+	isl_set *set;
+	isl_basic_set *bset;
+	int level;
+	int dim;
+};
+
+/* Add the given constraint to ctb->bset, unless it is an inequality
+ * that bounds some of the dimensions after the first ctb->level ones
+ * without involving any of the first ctb->level dimensions
+ * or any existentially quantified variable.
+ */
+static int constraint_tile_bound(__isl_take isl_constraint *c, void *user)
+{
+	struct cloog_tile_bounds *ctb = (struct cloog_tile_bounds *)user;
+	int n_div = isl_constraint_dim(c, isl_dim_div);
+
+	if (!isl_constraint_is_equality(c) &&
+	    !isl_constraint_involves_dims(c, isl_dim_set, 0, ctb->level) &&
+	    !isl_constraint_involves_dims(c, isl_dim_div, 0, n_div) &&
+	    isl_constraint_involves_dims(c, isl_dim_set, ctb->level,
+					 ctb->dim - ctb->level)) {
+		isl_constraint_free(c);
+		return 0;
+	}
+
+	ctb->bset = isl_basic_set_intersect(ctb->bset,
+					    isl_basic_set_from_constraint(c));
+	return 0;
+}
+
+static int basic_set_tile_bounds(__isl_take isl_basic_set *bset, void *user)
+{
+	struct cloog_tile_bounds *ctb = (struct cloog_tile_bounds *)user;
+	int r;
+
+	ctb->bset = isl_basic_set_universe(isl_basic_set_get_space(bset));
+	r = isl_basic_set_foreach_constraint(bset, constraint_tile_bound, ctb);
+	isl_basic_set_free(bset);
+	ctb->set = isl_set_union(ctb->set, isl_set_from_basic_set(ctb->bset));
+	return r;
+}
+
+/**
+ * Return the set of values of the first "level" dimensions of "dom"
+ * for which "dom" does not contain the whole tile of values
+ * of the later dimensions.
+ * The tiles are obtained by dropping from "dom" the inequalities that
+ * bound some of the later dimensions without involving any of
+ * the first "level" dimensions.  For a tiled domain, these are the
+ * bounds of the original domain, while the bounds that relate
+ * the point dimensions to the tile dimensions are kept.
+ * The result is the set of partial tiles.  If the later dimensions
+ * are not tiled, then the "tiles" are unbounded and the result
+ * contains every value of the first "level" dimensions in "dom".
+ */
+CloogDomain *cloog_domain_partial_tiles(CloogDomain *dom, int level)
+{
+	struct cloog_tile_bounds ctb;
+	isl_set *set = isl_set_from_cloog_domain(dom);
+	int r;
+
+	ctb.level = level;
+	ctb.dim = isl_set_dim(set, isl_dim_set);
+	ctb.set = isl_set_empty(isl_set_get_space(set));
+	r = isl_set_foreach_basic_set(set, basic_set_tile_bounds, &ctb);
+	assert(r == 0);
+	ctb.set = isl_set_subtract(ctb.set, isl_set_copy(set));
+	ctb.set = isl_set_project_out(ctb.set, isl_dim_set, level,
+				      ctb.dim - level);
+	return cloog_domain_from_isl_set(ctb.set);
+}
+
 
 /* Check whether the union of scattering functions over all domains
  * is obviously injective.
@@ -1332,6 +2188,321 @@ int cloog_domain_lazy_disjoint(CloogDomain *d1, CloogDomain *d2)
 	isl_set *set2 = isl_set_from_cloog_domain(d2);
 	return isl_set_plain_is_disjoint(set1, set2);
 } 
+
+
+/**
+ * A CloogDomainBox is a cheap over-approximation of a domain: for each
+ * set dimension x, it keeps the lower and upper bounds on x that appear
+ * as constraints of the domain involving no other set dimension,
+ *	lower[x] . (p, 1) <= x <= upper[x] . (p, 1),
+ * where p are the parameters.  A NULL bound is unknown.
+ * Boxes are obtained without solving any (I)LP, such that comparing
+ * the boxes of two domains is much cheaper than comparing the domains.
+ */
+struct cloogdomainbox {
+	int dim;
+	int nparam;
+	struct cloog_vec **lower;
+	struct cloog_vec **upper;
+};
+
+static CloogDomainBox *cloog_domain_box_alloc(int dim, int nparam)
+{
+	CloogDomainBox *box;
+
+	box = (CloogDomainBox *)malloc(sizeof(CloogDomainBox));
+	if (!box)
+		cloog_die("memory overflow.\n");
+	box->dim = dim;
+	box->nparam = nparam;
+	box->lower = (struct cloog_vec **)calloc(dim, sizeof(struct cloog_vec *));
+	box->upper = (struct cloog_vec **)calloc(dim, sizeof(struct cloog_vec *));
+	if (dim && (!box->lower || !box->upper))
+		cloog_die("memory overflow.\n");
+	return box;
+}
+
+void cloog_domain_box_free(CloogDomainBox *box)
+{
+	int i;
+
+	if (!box)
+		return;
+	for (i = 0; i < box->dim; ++i) {
+		cloog_vec_free(box->lower[i]);
+		cloog_vec_free(box->upper[i]);
+	}
+	free(box->lower);
+	free(box->upper);
+	free(box);
+}
+
+/* Do bounds "b1" and "b2" have the same parametric part?
+ */
+static int bound_same_params(struct cloog_vec *b1, struct cloog_vec *b2)
+{
+	int i;
+
+	for (i = 0; i + 1 < b1->size; ++i)
+		if (cloog_int_ne(b1->p[i], b2->p[i]))
+			return 0;
+	return 1;
+}
+
+/* Replace *bound by "new" if *bound is unknown or if it has the same
+ * parametric part and "new" is tighter ("sign" is 1 for a lower bound
+ * and -1 for an upper bound).  Otherwise, keep the known bound.
+ */
+static void bound_tighten(struct cloog_vec **bound, struct cloog_vec *new,
+	int sign)
+{
+	int last = new->size - 1;
+
+	if (!*bound) {
+		*bound = new;
+		return;
+	}
+	if (bound_same_params(*bound, new) &&
+	    sign * cloog_int_cmp(new->p[last], (*bound)->p[last]) > 0)
+		cloog_int_swap((*bound)->p[last], new->p[last]);
+	cloog_vec_free(new);
+}
+
+/* Replace *bound by a bound that also holds for "other"
+ * ("sign" is 1 for a lower bound and -1 for an upper bound),
+ * i.e., the loosest of the two if they have the same parametric part
+ * and no bound otherwise.
+ */
+static void bound_relax(struct cloog_vec **bound, struct cloog_vec *other,
+	int sign)
+{
+	int last;
+
+	if (!*bound)
+		return;
+	last = (*bound)->size - 1;
+	if (other && bound_same_params(*bound, other)) {
+		if (sign * cloog_int_cmp(other->p[last], (*bound)->p[last]) < 0)
+			cloog_int_set((*bound)->p[last], other->p[last]);
+		return;
+	}
+	cloog_vec_free(*bound);
+	*bound = NULL;
+}
+
+/* Extract a bound from constraint "c" (of the form
+ *	a x + b . p + c >= 0  or  a x + b . p + c = 0
+ * with a = 1 or a = -1 and x the only set dimension in "c")
+ * and add it to the box "user".
+ */
+static isl_stat add_bound(__isl_take isl_constraint *c, void *user)
+{
+	CloogDomainBox *box = (CloogDomainBox *)user;
+	int i, pos = -1, sign = 0;
+	isl_val *v;
+	struct cloog_vec *bound;
+
+	if (isl_constraint_involves_dims(c, isl_dim_div, 0,
+				isl_constraint_dim(c, isl_dim_div))) {
+		isl_constraint_free(c);
+		return isl_stat_ok;
+	}
+
+	for (i = 0; i < box->dim; ++i) {
+		v = isl_constraint_get_coefficient_val(c, isl_dim_set, i);
+		if (isl_val_is_zero(v)) {
+			isl_val_free(v);
+			continue;
+		}
+		if (pos >= 0 || !(isl_val_is_one(v) || isl_val_is_negone(v)))
+			pos = -2;
+		else {
+			pos = i;
+			sign = isl_val_is_one(v) ? 1 : -1;
+		}
+		isl_val_free(v);
+		if (pos == -2)
+			break;
+	}
+	if (pos < 0) {
+		isl_constraint_free(c);
+		return isl_stat_ok;
+	}
+
+	/* Lower bound -(b . p + c) or upper bound b . p + c. */
+	bound = cloog_vec_alloc(box->nparam + 1);
+	for (i = 0; i < box->nparam; ++i) {
+		v = isl_constraint_get_coefficient_val(c, isl_dim_param, i);
+		isl_val_to_cloog_int(v, &bound->p[i]);
+		isl_val_free(v);
+	}
+	v = isl_constraint_get_constant_val(c);
+	isl_val_to_cloog_int(v, &bound->p[box->nparam]);
+	isl_val_free(v);
+	if (sign > 0)
+		cloog_seq_neg(bound->p, bound->p, bound->size);
+
+	if (isl_constraint_is_equality(c)) {
+		struct cloog_vec *other = cloog_vec_alloc(bound->size);
+		cloog_seq_cpy(other->p, bound->p, bound->size);
+		bound_tighten(&box->lower[pos], bound, 1);
+		bound_tighten(&box->upper[pos], other, -1);
+	} else if (sign > 0)
+		bound_tighten(&box->lower[pos], bound, 1);
+	else
+		bound_tighten(&box->upper[pos], bound, -1);
+
+	isl_constraint_free(c);
+	return isl_stat_ok;
+}
+
+struct cloog_domain_box_data {
+	int dim;
+	int nparam;
+	CloogDomainBox *box;
+};
+
+/* Extend the box of "user" to the box of "bset", or initialize it
+ * if "bset" is the first basic set.
+ */
+static isl_stat add_basic_set_box(__isl_take isl_basic_set *bset, void *user)
+{
+	struct cloog_domain_box_data *data;
+	CloogDomainBox *bbox;
+
+	data = (struct cloog_domain_box_data *)user;
+	bbox = cloog_domain_box_alloc(data->dim, data->nparam);
+	isl_basic_set_foreach_constraint(bset, &add_bound, bbox);
+	isl_basic_set_free(bset);
+
+	if (!data->box) {
+		data->box = bbox;
+		return isl_stat_ok;
+	}
+
+	data->box = cloog_domain_box_hull(data->box, bbox);
+	cloog_domain_box_free(bbox);
+	return isl_stat_ok;
+}
+
+/**
+ * cloog_domain_box function:
+ * This function computes the bounding box of a domain (see the
+ * CloogDomainBox structure), to be used by cloog_domain_box_disjoint.
+ */
+CloogDomainBox *cloog_domain_box(CloogDomain *domain)
+{
+	isl_set *set = isl_set_from_cloog_domain(domain);
+	struct cloog_domain_box_data data;
+
+	data.dim = isl_set_dim(set, isl_dim_set);
+	data.nparam = isl_set_dim(set, isl_dim_param);
+	data.box = NULL;
+	isl_set_foreach_basic_set(set, &add_basic_set_box, &data);
+
+	if (!data.box)
+		data.box = cloog_domain_box_alloc(data.dim, data.nparam);
+	return data.box;
+}
+
+static struct cloog_vec *bound_copy(struct cloog_vec *bound)
+{
+	int i;
+	struct cloog_vec *copy;
+
+	if (!bound)
+		return NULL;
+	copy = cloog_vec_alloc(bound->size);
+	for (i = 0; i < bound->size; ++i)
+		cloog_int_set(copy->p[i], bound->p[i]);
+	return copy;
+}
+
+/**
+ * cloog_domain_box_copy function:
+ * This function returns a copy of the box given as input.
+ */
+CloogDomainBox *cloog_domain_box_copy(CloogDomainBox *box)
+{
+	int i;
+	CloogDomainBox *copy;
+
+	copy = cloog_domain_box_alloc(box->dim, box->nparam);
+	for (i = 0; i < box->dim; ++i) {
+		copy->lower[i] = bound_copy(box->lower[i]);
+		copy->upper[i] = bound_copy(box->upper[i]);
+	}
+	return copy;
+}
+
+/**
+ * cloog_domain_box_hull function:
+ * This function extends the box (box1) such that it also contains the box
+ * (box2) and returns it.  Bounds that cannot be extended because their
+ * parametric parts differ are dropped.  (box1) is taken, (box2) is kept.
+ */
+CloogDomainBox *cloog_domain_box_hull(CloogDomainBox *box1,
+	CloogDomainBox *box2)
+{
+	int i;
+
+	for (i = 0; i < box1->dim; ++i) {
+		if (box1->dim != box2->dim || box1->nparam != box2->nparam) {
+			bound_relax(&box1->lower[i], NULL, 1);
+			bound_relax(&box1->upper[i], NULL, -1);
+			continue;
+		}
+		bound_relax(&box1->lower[i], box2->lower[i], 1);
+		bound_relax(&box1->upper[i], box2->upper[i], -1);
+	}
+	return box1;
+}
+
+/* Compare the boxes "box1" and "box2" at set dimension "pos".
+ * Return 1 if all elements of box1 are greater than all elements of box2
+ * at this position (for any value of the parameters), -1 if they are all
+ * smaller and 0 if the boxes cannot tell.
+ */
+static int cloog_domain_box_compare_at(CloogDomainBox *box1,
+	CloogDomainBox *box2, int pos)
+{
+	struct cloog_vec *lower, *upper;
+	int last = box1->nparam;
+
+	if (box1->nparam != box2->nparam ||
+	    pos >= box1->dim || pos >= box2->dim)
+		return 0;
+
+	lower = box1->lower[pos];
+	upper = box2->upper[pos];
+	if (lower && upper && bound_same_params(lower, upper) &&
+	    cloog_int_gt(lower->p[last], upper->p[last]))
+		return 1;
+
+	lower = box2->lower[pos];
+	upper = box1->upper[pos];
+	if (lower && upper && bound_same_params(lower, upper) &&
+	    cloog_int_gt(lower->p[last], upper->p[last]))
+		return -1;
+
+	return 0;
+}
+
+/**
+ * cloog_domain_box_disjoint function:
+ * This function returns 1 if the domains of the boxes given as input
+ * are disjoint, i.e., if they do not overlap in some dimension,
+ * and 0 if the boxes cannot tell.
+ */
+int cloog_domain_box_disjoint(CloogDomainBox *box1, CloogDomainBox *box2)
+{
+	int i;
+
+	for (i = 0; i < box1->dim; ++i)
+		if (cloog_domain_box_compare_at(box1, box2, i))
+			return 1;
+	return 0;
+}
  
  
 /**
@@ -2101,3 +3272,47 @@ CloogDomain *cloog_domain_fixed_offset(CloogDomain *domain,
 
 	return cloog_domain_from_isl_set(set);
 }
+
+
+/* Return the elements x of "domain" shifted by -offset along the iterator
+ * at the given level, i.e., the elements x such that x + offset e_level
+ * belongs to "domain".
+ */
+CloogDomain *cloog_domain_shift(CloogDomain *domain, int level, int offset)
+{
+	isl_set *set = isl_set_from_cloog_domain(domain);
+	isl_space *space;
+	isl_multi_aff *ma;
+	isl_aff *aff;
+
+	space = isl_space_map_from_set(isl_set_get_space(set));
+	ma = isl_multi_aff_identity(space);
+	aff = isl_multi_aff_get_aff(ma, level - 1);
+	aff = isl_aff_add_constant_si(aff, offset);
+	ma = isl_multi_aff_set_aff(ma, level - 1, aff);
+	set = isl_set_preimage_multi_aff(set, ma);
+
+	return cloog_domain_from_isl_set(set);
+}
+
+
+/* Return the elements of "domain" whose iterator at the given level
+ * is equal to "residue" modulo "modulo".
+ */
+CloogDomain *cloog_domain_residue(CloogDomain *domain, int level,
+	int modulo, int residue)
+{
+	isl_set *set = isl_set_from_cloog_domain(domain);
+	isl_ctx *ctx = isl_set_get_ctx(set);
+	isl_local_space *ls;
+	isl_aff *aff;
+
+	ls = isl_local_space_from_space(isl_set_get_space(set));
+	aff = isl_aff_var_on_domain(ls, isl_dim_set, level - 1);
+	aff = isl_aff_add_constant_si(aff, -residue);
+	aff = isl_aff_mod_val(aff, isl_val_int_from_si(ctx, modulo));
+	set = isl_set_intersect(set, isl_set_from_basic_set(
+					isl_aff_zero_basic_set(aff)));
+
+	return cloog_domain_from_isl_set(set);
+}
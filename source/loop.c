@@ -39,6 +39,10 @@
 
 # include <stdlib.h>
 # include <stdio.h>
+# include <string.h>
+# ifdef CLOOG_PTHREADS
+# include <pthread.h>
+# endif
 # include "../include/cloog/cloog.h"
 
 #define ALLOC(type) (type*)malloc(sizeof(type))
@@ -214,7 +218,7 @@ void cloog_loop_free(CloogLoop * loop)
     cloog_loop_free(loop->inner) ;
     
     cloog_stride_free(loop->stride);
-    free(loop) ;
+    cloog_state_node_free(loop->state, loop, sizeof(CloogLoop));
     loop = next ;
   }
 }
@@ -249,7 +253,7 @@ int domain, block, inner, next ;
     
     cloog_domain_free(loop->unsimplified);
     cloog_stride_free(loop->stride);
-    free(loop) ;
+    cloog_state_node_free(loop->state, loop, sizeof(CloogLoop));
     if (next)
     loop = follow ;
     else
@@ -339,9 +343,7 @@ CloogLoop *cloog_loop_malloc(CloogState *state)
 { CloogLoop * loop ;
   
   /* Memory allocation for the CloogLoop structure. */
-  loop = (CloogLoop *)malloc(sizeof(CloogLoop)) ;
-  if (loop == NULL) 
-    cloog_die("memory overflow.\n");
+  loop = (CloogLoop *)cloog_state_node_alloc(state, sizeof(CloogLoop));
   cloog_loop_leak_up(state);
  
   
@@ -498,12 +500,12 @@ CloogLoop ** start, ** now, * loop ;
     cloog_loop_add(start,now,sep) ;
   
     seen = cloog_domain_copy(domain);
-    while (!cloog_domain_isempty(domain = rest)) {
+    while (!cloog_domain_isempty_cached(loop->state, domain = rest)) {
       temp = cloog_domain_cut_first(domain, &rest);
-      domain = cloog_domain_difference(temp, seen);
+      domain = cloog_domain_difference_cached(loop->state, temp, seen);
       cloog_domain_free(temp);
 
-      if (cloog_domain_isempty(domain)) {
+      if (cloog_domain_isempty_cached(loop->state, domain)) {
 	cloog_domain_free(domain);
 	continue;
       }
@@ -523,7 +525,7 @@ CloogLoop ** start, ** now, * loop ;
       else
 	cloog_loop_add_disjoint(start,now,sep) ;
 
-      if (cloog_domain_isempty(rest)) {
+      if (cloog_domain_isempty_cached(loop->state, rest)) {
 	cloog_domain_free(domain);
 	break;
       }
@@ -584,13 +586,15 @@ CloogLoop *cloog_loop_restrict(CloogLoop *loop, CloogDomain *context)
   {
     new_dimension = cloog_domain_dimension(domain);
     extended_context = cloog_domain_extend(context, new_dimension);
-    new_domain = cloog_domain_intersection(extended_context,loop->domain) ;
+    new_domain = cloog_domain_intersection_cached(loop->state,
+						  extended_context, loop->domain);
     cloog_domain_free(extended_context) ;
   }
   else
-  new_domain = cloog_domain_intersection(context,loop->domain) ;
+  new_domain = cloog_domain_intersection_cached(loop->state, context,
+						loop->domain);
   
-  if (cloog_domain_isempty(new_domain))
+  if (cloog_domain_isempty_cached(loop->state, new_domain))
   { cloog_domain_free(new_domain) ;
     return(NULL) ;
   }
@@ -629,6 +633,30 @@ CloogLoop *cloog_loop_restrict_all(CloogLoop *loop, CloogDomain *context)
 }
 
 
+/**
+ * Call cloog_loop_restrict on each loop in the list "loop" and return
+ * the concatenated result, leaving "loop" untouched.  Only the loops
+ * with a non-empty restriction are copied.
+ */
+static CloogLoop *cloog_loop_restrict_all_copy(CloogLoop *loop,
+	CloogDomain *context)
+{
+    CloogLoop *res = NULL;
+    CloogLoop **res_next = &res;
+
+    for (; loop; loop = loop->next) {
+	*res_next = cloog_loop_restrict(loop, context);
+	if (!*res_next)
+	    continue;
+	(*res_next)->block = cloog_block_copy(loop->block);
+	(*res_next)->inner = cloog_loop_copy(loop->inner);
+	res_next = &(*res_next)->next;
+    }
+
+    return res;
+}
+
+
 /**
  * Restrict the domains of the inner loops of each loop l in the given
  * list of loops to the domain of the loop l.  If the domains of all
@@ -680,7 +708,8 @@ CloogLoop * cloog_loop_project(CloogLoop * loop, int level)
   if (cloog_domain_dimension(loop->domain) == level)
   new_domain = cloog_domain_copy(loop->domain) ;  
   else
-    new_domain = cloog_domain_project(loop->domain, level);
+    new_domain = cloog_domain_project_cached(loop->state, loop->domain,
+						     level);
 
   new_loop = cloog_loop_alloc(loop->state, new_domain, 0, NULL,
 			      NULL, copy, NULL);
@@ -769,7 +798,7 @@ CloogLoop *cloog_loop_remove_empty_domain_loops(CloogLoop *loop)
     res_next = &res;
     for (l = loop; l; l = next) {
 	next = l->next;
-	if (cloog_domain_isempty(l->domain))
+	if (cloog_domain_isempty_cached(l->state, l->domain))
 	    cloog_loop_free_parts(l, 1, 1, 1, 0);
 	else {
 	    *res_next = l;
@@ -781,6 +810,33 @@ CloogLoop *cloog_loop_remove_empty_domain_loops(CloogLoop *loop)
     return res;
 }
 
+/**
+ * Remove loops from list that have a domain that is known to contain
+ * no integral points, along with their inner loops.  Only the cheap test
+ * of cloog_domain_lazy_never_integral is performed since the polyhedra
+ * computed by separation have already been checked for emptiness.
+ */
+static CloogLoop *cloog_loop_remove_never_integral_loops(CloogLoop *loop)
+{
+    CloogLoop *l, *res, *next, **res_next;
+
+    res = NULL;
+    res_next = &res;
+    for (l = loop; l; l = next) {
+	next = l->next;
+	if (cloog_domain_lazy_never_integral(l->state, l->domain)) {
+	    l->next = NULL;
+	    cloog_loop_free(l);
+	} else {
+	    *res_next = l;
+	    res_next = &(*res_next)->next;
+	}
+    }
+    *res_next = NULL;
+
+    return res;
+}
+
 CloogLoop *cloog_loop_decompose_inner(CloogLoop *loop,
 	int level, int scalar, int *scaldims, int nb_scattdims);
 
@@ -807,7 +863,7 @@ CloogLoop *cloog_loop_specialize(CloogLoop *loop,
 	    continue;
 
 	dim = cloog_domain_dimension(l->domain);
-	domain = cloog_domain_project(l->inner->domain, dim);
+	domain = cloog_domain_project_cached(l->state, l->inner->domain, dim);
 	if (cloog_domain_isconvex(domain)) {
 	    cloog_domain_free(l->domain);
 	    l->domain = domain;
@@ -837,9 +893,9 @@ CloogLoop *cloog_loop_propagate_lower_bound(CloogLoop *loop, int level)
 	    continue;
 
 	dim = cloog_domain_dimension(l->domain);
-	domain = cloog_domain_project(l->inner->domain, dim);
+	domain = cloog_domain_project_cached(l->state, l->inner->domain, dim);
 	if (cloog_domain_isconvex(domain)) {
-	    t = cloog_domain_intersection(domain, l->domain);
+	    t = cloog_domain_intersection_cached(l->state, domain, l->domain);
 	    cloog_domain_free(l->domain);
 	    l->domain = t;
 	}
@@ -849,6 +905,212 @@ CloogLoop *cloog_loop_propagate_lower_bound(CloogLoop *loop, int level)
     return loop;
 }
 
+static int cloog_loop_count(CloogLoop *loop)
+{
+    int nb_loops;
+
+    for (nb_loops = 0; loop; loop = loop->next)
+	nb_loops++;
+
+    return  nb_loops;
+}
+
+
+/* The indices, in decreasing order, of the loops of the input list of
+ * cloog_loop_separate whose inner loops are the inner loops of a polyhedron.
+ * These lists are immutable and shared between the polyhedra obtained from
+ * a common polyhedron, such that the inner loops are only built (copied)
+ * once, for the polyhedra that are left at the end of the separation.
+ */
+struct cloog_loop_from {
+    int references;
+    int index;
+    struct cloog_loop_from *next;
+};
+
+static struct cloog_loop_from *cloog_loop_from_alloc(int index,
+	struct cloog_loop_from *next)
+{
+    struct cloog_loop_from *from;
+
+    from = (struct cloog_loop_from *)malloc(sizeof(struct cloog_loop_from));
+    if (!from)
+	cloog_die("memory overflow.\n");
+    from->references = 1;
+    from->index = index;
+    from->next = next;
+    return from;
+}
+
+static struct cloog_loop_from *cloog_loop_from_copy(
+	struct cloog_loop_from *from)
+{
+    if (from)
+	from->references++;
+    return from;
+}
+
+static void cloog_loop_from_free(struct cloog_loop_from *from)
+{
+    struct cloog_loop_from *next;
+
+    for (; from && --from->references == 0; from = next) {
+	next = from->next;
+	free(from);
+    }
+}
+
+
+/* The polyhedra of a list of loops during cloog_loop_separate, in the same
+ * order: the bounding boxes of their domains, which let cloog_loop_separate
+ * skip most pairs of disjoint domains without intersecting them, whether
+ * they are settled, i.e., whether their box is disjoint from the boxes of
+ * all the loops that remain to be separated, and where their inner loops
+ * come from.
+ */
+struct cloog_loop_pieces {
+    int n;
+    int size;
+    CloogDomainBox **box;
+    char *settled;
+    struct cloog_loop_from **from;
+};
+
+static void cloog_loop_pieces_add(struct cloog_loop_pieces *pieces,
+	CloogDomainBox *box, int settled, struct cloog_loop_from *from)
+{
+    if (pieces->n == pieces->size) {
+	pieces->size = 2 * pieces->size + 8;
+	pieces->box = (CloogDomainBox **)realloc(pieces->box,
+				pieces->size * sizeof(CloogDomainBox *));
+	pieces->settled = (char *)realloc(pieces->settled,
+				pieces->size * sizeof(char));
+	pieces->from = (struct cloog_loop_from **)realloc(pieces->from,
+			pieces->size * sizeof(struct cloog_loop_from *));
+	if (!pieces->box || !pieces->settled || !pieces->from)
+	    cloog_die("memory overflow.\n");
+    }
+    pieces->settled[pieces->n] = settled;
+    pieces->from[pieces->n] = from;
+    pieces->box[pieces->n++] = box;
+}
+
+/* Return the number of inner loop lists the polyhedra of "pieces" would
+ * get, i.e., the number of copies of the statements of the input loops
+ * they contain.
+ */
+static int cloog_loop_pieces_copies(struct cloog_loop_pieces *pieces)
+{
+    int i, copies = 0;
+    struct cloog_loop_from *from;
+
+    for (i = 0; i < pieces->n; ++i)
+	for (from = pieces->from[i]; from; from = from->next)
+	    copies++;
+
+    return copies;
+}
+
+static void cloog_loop_pieces_clear(struct cloog_loop_pieces *pieces)
+{
+    int i;
+
+    for (i = 0; i < pieces->n; ++i) {
+	cloog_domain_box_free(pieces->box[i]);
+	cloog_loop_from_free(pieces->from[i]);
+    }
+    pieces->n = 0;
+}
+
+static void cloog_loop_pieces_free(struct cloog_loop_pieces *pieces)
+{
+    cloog_loop_pieces_clear(pieces);
+    free(pieces->box);
+    free(pieces->settled);
+    free(pieces->from);
+}
+
+/* Add "loop" to the list of disjoint loops (start, now) as
+ * cloog_loop_add_disjoint does and the added polyhedra to "pieces",
+ * with "from" (which is taken) as origin of their inner loops.
+ * If a single loop is added with "domain" as domain, it takes over
+ * the box *reuse of this domain, if still available.
+ */
+static void cloog_loop_add_disjoint_piece(CloogLoop **start, CloogLoop **now,
+	CloogLoop *loop, struct cloog_loop_pieces *pieces,
+	CloogDomain *domain, CloogDomainBox **reuse,
+	struct cloog_loop_from *from)
+{
+    CloogLoop *first = *start ? *now : NULL;
+
+    cloog_loop_add_disjoint(start, now, loop);
+    first = first ? first->next : *start;
+
+    if (*reuse && first == *now && first->domain == domain) {
+	cloog_loop_pieces_add(pieces, *reuse, 0, from);
+	*reuse = NULL;
+	return;
+    }
+    if (!first)
+	cloog_loop_from_free(from);
+    for (; first; first = first->next)
+	cloog_loop_pieces_add(pieces, cloog_domain_box(first->domain), 0,
+			      first == *now ? from : cloog_loop_from_copy(from));
+}
+
+/* Build the inner loops of the separated polyhedra "res", where "pieces"
+ * describes the origin of their inner loops, from the inner loops of the
+ * loops of the input list "old".  The inner loops of each input loop are
+ * copied, unless "take" is set, in which case they are taken over by their
+ * last use (or freed if they are not used) and removed from "old".
+ */
+static void cloog_loop_pieces_inner(CloogLoop *res,
+	struct cloog_loop_pieces *pieces, CloogLoop *old, int take)
+{
+    int i, j, k, n;
+    int *uses, *index;
+    CloogLoop **input, *part;
+    struct cloog_loop_from *from;
+
+    n = cloog_loop_count(old);
+    uses = (int *)calloc(n, sizeof(int));
+    index = (int *)malloc(n * sizeof(int));
+    input = (CloogLoop **)malloc(n * sizeof(CloogLoop *));
+    if (!uses || !index || !input)
+	cloog_die("memory overflow.\n");
+    for (k = 0; old; k++, old = old->next)
+	input[k] = old;
+    for (i = 0; i < pieces->n; ++i)
+	for (from = pieces->from[i]; from; from = from->next)
+	    uses[from->index]++;
+
+    for (i = 0; i < pieces->n; ++i, res = res->next) {
+	j = 0;
+	for (from = pieces->from[i]; from; from = from->next)
+	    index[j++] = from->index;
+	while (j-- > 0) {
+	    k = index[j];
+	    if (take && --uses[k] == 0) {
+		part = input[k]->inner;
+		input[k]->inner = NULL;
+	    } else
+		part = cloog_loop_copy(input[k]->inner);
+	    res->inner = cloog_loop_concat(res->inner, part);
+	}
+    }
+
+    if (take)
+	for (k = 0; k < n; k++) {
+	    cloog_loop_free(input[k]->inner);
+	    input[k]->inner = NULL;
+	}
+
+    free(uses);
+    free(index);
+    free(input);
+}
+
+
 /**
  * cloog_loop_separate function:
  * This function implements the Quillere algorithm for separation of multiple
@@ -865,11 +1127,86 @@ CloogLoop *cloog_loop_propagate_lower_bound(CloogLoop *loop, int level)
  *                        without now, DomainSimplify may have been improved).
  *                        The problem was visible with test/iftest2.cloog.
  */ 
-CloogLoop * cloog_loop_separate(CloogLoop * loop)
-{ int lazy_equal=0, disjoint = 0;
-  CloogLoop * new_loop, * new_inner, * res, * now, * temp, * Q, 
-            * inner, * old /*, * previous, * next*/  ;
+CloogLoop *cloog_loop_separate_budget(CloogLoop *loop, CloogOptions *options,
+	int *exceeded);
+
+CloogLoop *cloog_loop_separate(CloogLoop *loop)
+{
+  return cloog_loop_separate_budget(loop, NULL, NULL);
+}
+
+
+/**
+ * cloog_loop_fallback function:
+ * This function checks whether the isl operations performed since the last
+ * check exceed options->max_operations and, in that case, switches to the
+ * next cheaper strategy of enum cloog_fallback for the rest of the code
+ * generation.  It returns the strategy in use.
+ */
+static int cloog_loop_fallback(CloogState *state, CloogOptions *options)
+{
+  static const char *strategy[] = {
+    NULL,
+    "simple hulls without backtracking",
+    "merging the loops of the remaining levels with exact hulls"
+  };
+
+  if ((options->max_operations >= 0) &&
+      (options->fallback < CLOOG_FALLBACK_MERGE) &&
+      cloog_state_max_operations_exceeded(state))
+  { options->fallback++ ;
+    cloog_msg(options, CLOOG_WARNING,
+	      "more than %d isl operations are needed, falling back\n"
+	      "                to %s.\n",
+	      options->max_operations, strategy[options->fallback]);
+  }
+
+  return options->fallback ;
+}
+
+
+/* Return 1 if "domain" contains "outer".
+ */
+static int cloog_loop_covers(CloogState *state, CloogDomain *domain,
+	CloogDomain *outer)
+{
+  int covers;
+  CloogDomain *diff;
+
+  if (cloog_domain_lazy_equal(domain, outer))
+    return 1;
+  diff = cloog_domain_difference_cached(state, outer, domain);
+  covers = cloog_domain_isempty_cached(state, diff);
+  cloog_domain_free(diff);
+
+  return covers;
+}
+
+
+/**
+ * loop_separate function:
+ * This function is the implementation of cloog_loop_separate_budget.
+ * If outer is not NULL, it is a domain that is known to hold many of the
+ * loops of the list, e.g., the domain of the outer loop of the projections
+ * of the inner loops that cloog_loop_generate_backtrack separates.
+ * Once the union UQ of the domains of the previous loops covers outer,
+ * the polyhedron (loop - UQ) is empty for every next loop that is a subset
+ * of outer and it is not computed: checking that the loop is a subset of
+ * outer is cheaper than computing the difference with the union of
+ * the domains of all the previous loops.  The result is the same.
+ */
+static CloogLoop *loop_separate(CloogLoop *loop, CloogDomain *outer,
+	CloogOptions *options, int *exceeded)
+{ int lazy_equal=0, disjoint = 0, settled, budget, max, size, i, k, n;
+  int copies, give_up = 0, covered;
+  CloogLoop * new_loop, * res, * now, * temp, * Q, * old, * next_Q, * done,
+            * last ;
   CloogDomain *UQ, *domain;
+  CloogDomainBox *box, **lbox, **rest;
+  struct cloog_loop_from *from;
+  struct cloog_loop_pieces pieces = { 0, 0, NULL, NULL, NULL };
+  struct cloog_loop_pieces next = { 0, 0, NULL, NULL, NULL }, swap;
+  struct cloog_loop_pieces finished = { 0, 0, NULL, NULL, NULL };
   
   if (loop == NULL)
   return NULL ;
@@ -878,35 +1215,98 @@ CloogLoop * cloog_loop_separate(CloogLoop * loop)
   
   if (loop->next == NULL)
   return cloog_loop_disjoint(loop) ;
-     
+
+  max = options ? options->separate_budget : -1 ;
+  size = options ? options->size_budget : -1 ;
+  budget = (max >= 0) || (size >= 0) ||
+           (options && (options->max_operations >= 0)) ;
+
+  /* lbox[k] is the box of the k-th loop and rest[k] is the hull of the
+   * boxes of the loops after the k-th one.  A polyhedron whose box is
+   * disjoint from rest[k] at the end of the k-th step is settled: it is
+   * carried along without any further domain operation, and if all the
+   * polyhedra before it are settled too, it leaves the list for good
+   * (to the list "done", which keeps the order of the result).
+   */
+  n = cloog_loop_count(loop);
+  lbox = (CloogDomainBox **)malloc(n * sizeof(CloogDomainBox *));
+  rest = (CloogDomainBox **)malloc(n * sizeof(CloogDomainBox *));
+  if (!lbox || !rest)
+    cloog_die("memory overflow.\n");
+  for (k = 0, Q = loop; Q; k++, Q = Q->next)
+    lbox[k] = cloog_domain_box(Q->domain);
+  rest[0] = rest[n - 1] = NULL;
+  for (k = n - 2; k > 0; k--)
+  { rest[k] = cloog_domain_box_copy(lbox[k + 1]);
+    if (rest[k + 1])
+      rest[k] = cloog_domain_box_hull(rest[k], rest[k + 1]);
+  }
+
+  /* The polyhedra have no inner loops until the end of the separation,
+   * their origin is recorded in "pieces" instead.
+   */
   UQ     = cloog_domain_copy(loop->domain) ;
+  covered = outer && cloog_loop_covers(loop->state, loop->domain, outer);
   domain = cloog_domain_copy(loop->domain) ;
-  res    = cloog_loop_alloc(loop->state, domain, 0, NULL,
-			    loop->block, loop->inner, NULL);
+  res    = cloog_loop_alloc(loop->state, domain, 0, NULL, NULL, NULL, NULL);
+  cloog_loop_pieces_add(&pieces, lbox[0], 0, cloog_loop_from_alloc(0, NULL));
+  lbox[0] = NULL;
+  done = last = NULL;
   	  
   old = loop ;
-  while((loop = loop->next) != NULL)
+  for (k = 1; (loop = loop->next) != NULL; k++)
   { temp = NULL ;
+    box = lbox[k];
+    lbox[k] = NULL;
     
     /* For all Q, add Q-loop associated with the blocks of Q alone,
      * and Q inter loop associated with the blocks of Q and loop.
      */
-    for (Q = res; Q; Q = Q->next) {
+    for (Q = res, i = 0; Q; Q = next_Q, i++) {
+        next_Q = Q->next;
+        Q->next = NULL;
+
+        /* A polyhedron of a previous step that is disjoint from loop is
+         * left as is (the first one may not be convex or may be empty).
+         */
+        if (pieces.settled[i] ||
+            ((k > 1) && cloog_domain_box_disjoint(pieces.box[i], box))) {
+          settled = pieces.settled[i] ||
+                    (rest[k] && cloog_domain_box_disjoint(pieces.box[i],
+                                                          rest[k]));
+          if (settled && (temp == NULL)) {
+            cloog_loop_add(&done, &last, Q);
+            cloog_domain_box_free(pieces.box[i]);
+            cloog_loop_pieces_add(&finished, NULL, 1, pieces.from[i]);
+          }
+          else {
+            cloog_loop_add(&temp, &now, Q);
+            cloog_loop_pieces_add(&next, pieces.box[i], settled,
+                                  pieces.from[i]);
+          }
+          pieces.box[i] = NULL;
+          pieces.from[i] = NULL;
+          continue;
+        }
+
         /* Add (Q inter loop). */
-        if ((disjoint = cloog_domain_lazy_disjoint(Q->domain,loop->domain)))
+        if ((disjoint = cloog_domain_box_disjoint(pieces.box[i], box) ||
+                        cloog_domain_lazy_disjoint(Q->domain,loop->domain)))
 	domain = NULL ;
 	else
 	{ if ((lazy_equal = cloog_domain_lazy_equal(Q->domain,loop->domain)))
 	  domain = cloog_domain_copy(Q->domain) ;
           else
-	  domain = cloog_domain_intersection(Q->domain,loop->domain) ;
+	  domain = cloog_domain_intersection_cached(loop->state, Q->domain,
+						    loop->domain);
           
-	  if (!cloog_domain_isempty(domain))
-          { new_inner = cloog_loop_concat(cloog_loop_copy(Q->inner),
-                                          cloog_loop_copy(loop->inner)) ;
+	  if (!cloog_domain_isempty_cached(loop->state, domain))
+          { from = cloog_loop_from_alloc(k,
+                                  cloog_loop_from_copy(pieces.from[i]));
 	    new_loop = cloog_loop_alloc(loop->state, domain, 0, NULL,
-					NULL, new_inner, NULL);
-            cloog_loop_add_disjoint(&temp,&now,new_loop) ;
+					NULL, NULL, NULL);
+            cloog_loop_add_disjoint_piece(&temp, &now, new_loop, &next,
+                                          Q->domain, &pieces.box[i], from);
           }
           else {
 	    disjoint = 1;
@@ -921,64 +1321,155 @@ CloogLoop * cloog_loop_separate(CloogLoop * loop)
 	{ if (lazy_equal)
 	  domain = cloog_domain_empty(Q->domain);
 	  else
-	  domain = cloog_domain_difference(Q->domain,loop->domain) ;
+	  domain = cloog_domain_difference_cached(loop->state, Q->domain,
+						  loop->domain);
 	}
 	
-	if (!cloog_domain_isempty(domain)) {
+	if (!cloog_domain_isempty_cached(loop->state, domain)) {
           new_loop = cloog_loop_alloc(loop->state, domain, 0, NULL,
-				      NULL, Q->inner, NULL);
-          cloog_loop_add_disjoint(&temp,&now,new_loop) ;
+				      NULL, NULL, NULL);
+          cloog_loop_add_disjoint_piece(&temp, &now, new_loop, &next,
+                                        Q->domain, &pieces.box[i],
+                                        pieces.from[i]);
+          pieces.from[i] = NULL;
         }
         else
-        { cloog_domain_free(domain) ;
-	  /* If Q->inner is no more useful, we can free it. */
-          inner = Q->inner ;
-          Q->inner = NULL ;
-          cloog_loop_free(inner) ;
-        }
+        cloog_domain_free(domain) ;
+        cloog_loop_free_parts(Q,1,0,0,0) ;
     }
 
     /* Add loop-UQ associated with the blocks of loop alone.*/
-    if (cloog_domain_lazy_disjoint(loop->domain,UQ))
+    if (covered && cloog_loop_covers(loop->state, outer, loop->domain))
+    domain = NULL ;
+    else if (cloog_domain_lazy_disjoint(loop->domain,UQ))
     domain = cloog_domain_copy(loop->domain) ;
     else
     { if (cloog_domain_lazy_equal(loop->domain,UQ))
       domain = cloog_domain_empty(UQ);
       else
-      domain = cloog_domain_difference(loop->domain,UQ) ;
+      domain = cloog_domain_difference_cached(loop->state, loop->domain,UQ) ;
     }
     
-    if (!cloog_domain_isempty(domain)) {
+    if (domain && !cloog_domain_isempty_cached(loop->state, domain)) {
       new_loop = cloog_loop_alloc(loop->state, domain, 0, NULL,
-				  NULL, loop->inner, NULL);
-      cloog_loop_add_disjoint(&temp,&now,new_loop) ;
+				  NULL, NULL, NULL);
+      cloog_loop_add_disjoint_piece(&temp, &now, new_loop, &next,
+                                    loop->domain, &box,
+                                    cloog_loop_from_alloc(k, NULL));
     }
     else
-    { cloog_domain_free(domain) ;
-      /* If loop->inner is no more useful, we can free it. */
-      cloog_loop_free(loop->inner) ;
-    }
-    
-    loop->inner = NULL ;
+    cloog_domain_free(domain) ;
 
+    if (outer && !covered)
+      covered = cloog_loop_covers(loop->state, loop->domain, outer);
     if (loop->next != NULL)
       UQ = cloog_domain_union(UQ, cloog_domain_copy(loop->domain));
     else
-      cloog_domain_free(UQ);
+    { cloog_domain_free(UQ);
+      UQ = NULL ;
+    }
 
-    cloog_loop_free_parts(res,1,0,0,1) ;
+    cloog_domain_box_free(box);
 
     res = temp ;
+    cloog_loop_pieces_clear(&pieces);
+    swap = pieces;
+    pieces = next;
+    next = swap;
+
+    /* Give up if the budget is exceeded and there is more work to do.
+     * The number of copies of the input loops never decreases.
+     */
+    if (budget && (loop->next != NULL) &&
+        (((max >= 0) && (finished.n + cloog_loop_count(res) > max)) ||
+         (cloog_loop_fallback(old->state, options) >= CLOOG_FALLBACK_MERGE)))
+      give_up = 1 ;
+    else if ((size >= 0) && (loop->next != NULL) &&
+             (cloog_loop_pieces_copies(&finished) +
+              cloog_loop_pieces_copies(&pieces) > size * n))
+      give_up = 2 ;
+    else if ((size >= 0) && (loop->next == NULL))
+    { copies = cloog_loop_pieces_copies(&finished) +
+               cloog_loop_pieces_copies(&pieces) ;
+      if ((copies > size * n) ||
+          (copies - n > (finished.n + pieces.n) * n - copies))
+        give_up = 2 ;
+    }
+
+    if (give_up)
+    { cloog_domain_free(UQ) ;
+      cloog_loop_free(done) ;
+      cloog_loop_free(res) ;
+      cloog_loop_pieces_free(&pieces);
+      cloog_loop_pieces_free(&next);
+      cloog_loop_pieces_free(&finished);
+      for (k = 0; k < n; k++)
+      { cloog_domain_box_free(lbox[k]);
+        cloog_domain_box_free(rest[k]);
+      }
+      free(lbox);
+      free(rest);
+      *exceeded = give_up ;
+      return old ;
+    }
   }  
-  cloog_loop_free_parts(old,1,0,0,1) ;
+
+  if (done != NULL)
+  { last->next = res ;
+    res = done ;
+  }
+  for (i = 0; i < pieces.n; ++i)
+  { cloog_loop_pieces_add(&finished, NULL, 0, pieces.from[i]);
+    pieces.from[i] = NULL;
+  }
+  cloog_loop_pieces_inner(res, &finished, old, !budget);
+
+  if (budget)
+    cloog_loop_free(old) ;
+  else
+    cloog_loop_free_parts(old,1,0,0,1) ;
+  cloog_loop_pieces_free(&pieces);
+  cloog_loop_pieces_free(&next);
+  cloog_loop_pieces_free(&finished);
+  for (k = 0; k < n; k++)
+    cloog_domain_box_free(rest[k]);
+  free(lbox);
+  free(rest);
 
   return(res) ;
 }
 
 
+/**
+ * cloog_loop_separate_budget function:
+ * This function performs the same separation as cloog_loop_separate, but
+ * gives up as soon as more than options->separate_budget polyhedra are alive
+ * at the end of one step of the algorithm (the number of polyhedra may grow
+ * exponentially with the number of loops), or when options->max_operations
+ * forces merging.  In that case, *exceeded is set to 1 and the input list
+ * (after combination of loops with the same domain) is returned, untouched,
+ * so that the caller may deal with it another way.
+ * When options->size_budget is set, it also gives up, setting *exceeded
+ * to 2, if merging the loops is the better choice: if the separated loops
+ * would contain more than options->size_budget copies of each of the n
+ * input loops on average, or if the copies of the input loops separation
+ * adds are more than the guards it saves, i.e., the number of pairs of
+ * a separated loop and an input loop that has no part in it (each of them
+ * stands for a guard that fails in some iterations of the merged loop).
+ * To be able to do so, the inner loops of the input list are copied rather
+ * than taken over by the separated loops when one of these limits is set.
+ * If options is NULL, no limit applies.
+ */
+CloogLoop *cloog_loop_separate_budget(CloogLoop *loop, CloogOptions *options,
+	int *exceeded)
+{
+  return loop_separate(loop, NULL, options, exceeded);
+}
+
+
 static CloogDomain *bounding_domain(CloogDomain *dom, CloogOptions *options)
 {
-    if (options->sh)
+    if (options->sh || (options->fallback == CLOOG_FALLBACK_SIMPLE))
 	return cloog_domain_simple_convex(dom);
     else
 	return cloog_domain_convex(dom);
@@ -1018,8 +1509,9 @@ CloogLoop *cloog_loop_merge(CloogLoop *loop, int level, CloogOptions *options)
 
     new_domain = bounding_domain(temp, options);
 
-    if (level > 0 && !cloog_domain_is_bounded(new_domain, level) &&
-	    	     cloog_domain_is_bounded(temp, level)) {
+    if (level > 0 &&
+	!cloog_domain_is_bounded_cached(old->state, new_domain, level) &&
+	cloog_domain_is_bounded_cached(old->state, temp, level)) {
 	CloogDomain *splitter, *t2;
 
 	cloog_domain_free(new_domain);
@@ -1030,13 +1522,13 @@ CloogLoop *cloog_loop_merge(CloogLoop *loop, int level, CloogOptions *options)
 	    CloogDomain *first, *rest;
 	    first = cloog_domain_cut_first(splitter, &rest);
 	    splitter = rest;
-	    t2 = cloog_domain_intersection(first, temp);
+	    t2 = cloog_domain_intersection_cached(old->state, first, temp);
 	    cloog_domain_free(first);
 
 	    new_domain = bounding_domain(t2, options);
 	    cloog_domain_free(t2);
 
-	    if (cloog_domain_isempty(new_domain)) {
+	    if (cloog_domain_isempty_cached(old->state, new_domain)) {
 		cloog_domain_free(new_domain);
 		continue;
 	    }
@@ -1044,13 +1536,13 @@ CloogLoop *cloog_loop_merge(CloogLoop *loop, int level, CloogOptions *options)
 				   NULL, cloog_loop_copy(new_inner), res);
 	}
 
-	t2 = cloog_domain_intersection(splitter, temp);
+	t2 = cloog_domain_intersection_cached(old->state, splitter, temp);
 	cloog_domain_free(splitter);
 
 	new_domain = bounding_domain(t2, options);
 	cloog_domain_free(t2);
 
-	if (cloog_domain_isempty(new_domain)) {
+	if (cloog_domain_isempty_cached(old->state, new_domain)) {
 	    cloog_domain_free(new_domain);
 	    cloog_loop_free(new_inner);
 	} else
@@ -1068,17 +1560,6 @@ CloogLoop *cloog_loop_merge(CloogLoop *loop, int level, CloogOptions *options)
 }
 
 
-static int cloog_loop_count(CloogLoop *loop)
-{
-    int nb_loops;
-
-    for (nb_loops = 0; loop; loop = loop->next)
-	nb_loops++;
-
-    return  nb_loops;
-}
-
-
 /**
  * cloog_loop_sort function:
  * Adaptation from LoopGen 0.4 by F. Quillere. This function sorts a list of
@@ -1172,7 +1653,7 @@ CloogLoop *cloog_loop_nest(CloogLoop *loop, CloogDomain *context, int level)
        */
       if (cloog_domain_dimension(p->domain) >= level)
 	for (l = cloog_domain_dimension(p->domain); l >= level; l--) {
-	  new_domain = cloog_domain_project(p->domain, l);
+	  new_domain = cloog_domain_project_cached(p->state, p->domain, l);
 	  temp = cloog_loop_alloc(p->state, new_domain, 0, NULL,
 				  NULL, temp, NULL);
 	}
@@ -1444,6 +1925,43 @@ int level, * scaldims, nb_scattdims, scalar ;
 }
 
 
+/* A loop and its vector of constant dimensions, for cloog_loop_scalar_sort.
+ */
+struct cloog_loop_scalar_key {
+  CloogLoop *loop;
+  cloog_int_t *key;    /* The scalar vector, starting at 'scalar'. */
+};
+
+/* Sort the n keys in "keys" (using "tmp" as a buffer of the same size)
+ * lexicographically on their first "len" values, keeping the order of
+ * keys that are equal.
+ */
+static void cloog_loop_scalar_merge_sort(struct cloog_loop_scalar_key *keys,
+	struct cloog_loop_scalar_key *tmp, int n, int len)
+{
+  int i, j, k, l, cmp, half = n / 2;
+
+  if (n < 2)
+    return;
+  cloog_loop_scalar_merge_sort(keys, tmp, half, len);
+  cloog_loop_scalar_merge_sort(keys + half, tmp, n - half, len);
+
+  for (i = 0, j = half, k = 0; i < half && j < n; ++k) {
+    for (l = 0, cmp = 0; !cmp && l < len; ++l)
+      cmp = cloog_int_cmp(keys[i].key[l], keys[j].key[l]);
+    if (cmp > 0)
+      tmp[k] = keys[j++];
+    else
+      tmp[k] = keys[i++];
+  }
+  while (i < half)
+    tmp[k++] = keys[i++];
+  while (j < n)
+    tmp[k++] = keys[j++];
+  memcpy(keys, tmp, n * sizeof(*keys));
+}
+
+
 /**
  * cloog_loop_scalar_sort function:
  * This function sorts a linked list of loops (loop) with respect to the
@@ -1451,6 +1969,8 @@ int level, * scaldims, nb_scattdims, scalar ;
  * be a succession of scalar dimensions, this function will reason about the
  * vector of scalar dimension that begins at dimension 'level+scalar' and
  * finish to the first non-scalar dimension.
+ * The scalar vector of each loop is looked up once and the loops are
+ * sorted by a stable merge sort on these vectors.
  * \param loop Loop list to sort.
  * \param level Current non-scalar dimension.
  * \param scaldims Boolean array saying whether a dimension is scalar or not.
@@ -1465,32 +1985,87 @@ int level, * scaldims, nb_scattdims, scalar ;
 CloogLoop * cloog_loop_scalar_sort(loop, level, scaldims, nb_scattdims, scalar)
 CloogLoop * loop ;
 int level, * scaldims, nb_scattdims, scalar ;
-{ int ok ;
-  CloogLoop **current;
-  
-  do {
-    ok = 1;
-    for (current = &loop; (*current)->next; current = &(*current)->next) {
-      CloogLoop *next = (*current)->next;
-      if (cloog_loop_scalar_gt(*current,next,level,scaldims,nb_scattdims,scalar)) {
-        ok = 0;
-	(*current)->next = next->next;
-	next->next = *current;
-	*current = next;
-      }
-    }
-  } while (!ok);
+{ int i, n, len ;
+  CloogLoop *l, **next;
+  struct cloog_loop_scalar_key *keys;
+
+  for (len = 0; level_is_constant(level, scalar + len, scaldims, nb_scattdims);
+       ++len)
+    ;
+  for (n = 0, l = loop; l; l = l->next)
+    n++;
+  if (n < 2 || len == 0)
+    return loop;
+
+  keys = (struct cloog_loop_scalar_key *)
+	 malloc(2 * n * sizeof(struct cloog_loop_scalar_key));
+  if (!keys)
+    cloog_die("memory overflow.\n");
+  for (i = 0, l = loop; l; ++i, l = l->next) {
+    keys[i].loop = l;
+    keys[i].key = l->block->scaldims + scalar;
+  }
+
+  cloog_loop_scalar_merge_sort(keys, keys + n, n, len);
+
+  next = &loop;
+  for (i = 0; i < n; ++i) {
+    *next = keys[i].loop;
+    next = &keys[i].loop->next;
+  }
+  *next = NULL;
+  free(keys);
 
   return loop ;
 }
 
 
+/**
+ * cloog_loop_scalar_group function:
+ * This function detaches from the list of loops (*loop), sorted by
+ * cloog_loop_scalar_sort on the scalar dimensions at the start of the
+ * scattering, the loops at its head that have the same values for these
+ * dimensions and returns them.  The whole list is returned if the first
+ * scattering dimension is not scalar.
+ * \param loop Pointer to the loop list to take the first group from.
+ * \param scaldims Boolean array saying whether a dimension is scalar or not.
+ * \param nb_scattdims Size of the scaldims array.
+ * \return The first group of loops, NULL if (*loop) is empty.
+ */
+CloogLoop *cloog_loop_scalar_group(CloogLoop **loop, int *scaldims,
+				   int nb_scattdims)
+{
+  CloogLoop *group = *loop, *end;
+
+  if (!group)
+    return NULL;
+
+  if (!level_is_constant(1, 0, scaldims, nb_scattdims)) {
+    *loop = NULL;
+    return group;
+  }
+
+  end = group;
+  while (end->next &&
+	 cloog_loop_scalar_eq(group, end->next, 1, scaldims, nb_scattdims, 0))
+    end = end->next;
+  *loop = end->next;
+  end->next = NULL;
+
+  return group;
+}
+
+
 /**
  * cloog_loop_generate_backtrack function:
  * adaptation from LoopGen 0.4 by F. Quillere. This function implements the
  * backtrack of the Quillere et al. algorithm (see the Quillere paper).
  * It eliminates unused iterations of the current level for the new one. See the
  * example called linearity-1-1 example with and without this part for an idea.
+ * The separation of the projections of the inner loops of each loop uses
+ * the domain of the loop, which the separation of the current level has
+ * already computed, to avoid some of its domain operations (see
+ * loop_separate).
  * - October 26th 2001: first version in cloog_loop_generate_general.
  * - July    31th 2002: (debug) no more parasite loops (REALLY hard !). 
  * - October 30th 2005: extraction from cloog_loop_generate_general.
@@ -1530,7 +2105,7 @@ CloogLoop *cloog_loop_generate_backtrack(CloogLoop *loop,
     temp->inner = NULL ;
       
     if (l != NULL)
-    { l = cloog_loop_separate(l) ;
+    { l = loop_separate(l, temp->domain, NULL, NULL) ;
       l = cloog_loop_sort(l, level);
       while (l != NULL) {
 	l->stride = cloog_stride_copy(l->stride);
@@ -1547,6 +2122,57 @@ CloogLoop *cloog_loop_generate_backtrack(CloogLoop *loop,
 }
 
 
+/**
+ * cloog_loop_hoist_guards function:
+ * this function is a cheaper alternative to cloog_loop_generate_backtrack.
+ * Instead of separating the projections of the inner loops of each loop at
+ * the current level, it intersects the domain of the loop with the (simple)
+ * convex hull of these projections. The constraints of the inner loops that
+ * do not depend on their own iterators, i.e., their guards, are thus hoisted
+ * into the bounds of the current loop or into its own guard, from which the
+ * caller, one level up, can hoist them further. They are then removed from
+ * the inner loops by cloog_loop_simplify. Loops are never split, hence the
+ * generated code is not larger than without hoisting.
+ * Loops with strides or statement blocks just inside are left unchanged,
+ * as in cloog_loop_generate_backtrack.
+ */
+static CloogLoop *cloog_loop_hoist_guards(CloogLoop *loop, int level)
+{
+  CloogLoop *temp, *inner;
+  CloogDomain *hull, *projection, *domain;
+
+  for (temp = loop; temp; temp = temp->next) {
+    if (temp->stride || !temp->inner)
+      continue;
+
+    hull = NULL;
+    for (inner = temp->inner; inner; inner = inner->next) {
+      if (inner->block)
+	break;
+      if (cloog_domain_dimension(inner->domain) == level)
+	projection = cloog_domain_copy(inner->domain);
+      else
+	projection = cloog_domain_project_cached(temp->state, inner->domain,
+						 level);
+      hull = hull ? cloog_domain_union(hull, projection) : projection;
+    }
+    if (inner) {
+      cloog_domain_free(hull);
+      continue;
+    }
+
+    domain = cloog_domain_simple_convex(hull);
+    cloog_domain_free(hull);
+    hull = temp->domain;
+    temp->domain = cloog_domain_intersection_cached(temp->state, hull, domain);
+    cloog_domain_free(hull);
+    cloog_domain_free(domain);
+  }
+
+  return loop;
+}
+
+
 /**
  * Return 1 if we need to continue recursing to the specified level.
  */
@@ -1631,6 +2257,7 @@ static CloogLoop *loop_unroll(CloogLoop *loop, int level)
     int can_unroll;
     cloog_int_t i;
     cloog_int_t n;
+    cloog_int_t last;
     CloogConstraint *lb;
     CloogLoop *res = NULL;
     CloogLoop **next_res = &res;
@@ -1645,12 +2272,17 @@ static CloogLoop *loop_unroll(CloogLoop *loop, int level)
     }
 
     cloog_int_init(i);
+    cloog_int_init(last);
 
     for (cloog_int_set_si(i, 0); cloog_int_lt(i, n); cloog_int_add_ui(i, i, 1)) {
 	domain = cloog_domain_copy(loop->domain);
 	domain = cloog_domain_fixed_offset(domain, level, lb, i);
-	inner = cloog_loop_copy(loop->inner);
-	inner = cloog_loop_restrict_all(inner, domain);
+	cloog_int_add_ui(last, i, 1);
+	if (cloog_int_eq(last, n)) {
+	    inner = cloog_loop_restrict_all(loop->inner, domain);
+	    loop->inner = NULL;
+	} else
+	    inner = cloog_loop_restrict_all_copy(loop->inner, domain);
 	if (!inner) {
 	    cloog_domain_free(domain);
 	    continue;
@@ -1661,6 +2293,7 @@ static CloogLoop *loop_unroll(CloogLoop *loop, int level)
     }
 
     cloog_int_clear(i);
+    cloog_int_clear(last);
     cloog_int_clear(n);
     cloog_constraint_release(lb);
 
@@ -1701,41 +2334,34 @@ CloogLoop *cloog_loop_recurse(CloogLoop *loop,
 	int level, int scalar, int *scaldims, int nb_scattdims,
 	int constant, CloogOptions *options);
 
+CloogLoop *cloog_loop_generate_general(CloogLoop *loop,
+	int level, int scalar, int *scaldims, int nb_scattdims,
+	CloogOptions *options);
+
 
 /**
- * Recurse on the inner loops of the given single loop.
- *
- * - loop is the loop for which we have to generate scanning code,
- * - level is the current non-scalar dimension,
- * - scalar is the current scalar dimension,
- * - scaldims is the boolean array saying whether a dimension is scalar or not,
- * - nb_scattdims is the size of the scaldims array,
- * - constant is true if the loop is known to be executed at most once
- * - options are the general code generation options.
+ * Return 1 if code generation with the given options may introduce
+ * strides on the generated loops, i.e., if it detects strides or
+ * unrolls loops partially.  Strided loops cannot be transferred to
+ * other threads or kept as components.
  */
-static CloogLoop *loop_recurse(CloogLoop *loop,
-	int level, int scalar, int *scaldims, int nb_scattdims,
-	int constant, CloogOptions *options)
+static int cloog_loop_may_stride(CloogOptions *options)
 {
-    CloogLoop *inner, *into, *end, *next, *l, *now;
-    CloogDomain *domain;
-
-    if (level && options->strides && !constant)
-      cloog_loop_stride(loop, level);
+    return options->strides || options->unroll_depth >= 0;
+}
 
-    if (!constant &&
-	options->first_unroll >= 0 && level + scalar >= options->first_unroll) {
-	loop = cloog_loop_unroll(loop, level);
-	if (loop->next)
-	    return cloog_loop_recurse(loop, level, scalar, scaldims,
-					nb_scattdims, 1, options);
-    }
 
-    if (level && options->otl)
-      cloog_loop_otl(loop, level);
-    inner = loop->inner;
-    domain = cloog_domain_copy(loop->domain);
-    domain = cloog_domain_add_stride_constraint(domain, loop->stride);
+/**
+ * Generate code for the inner loops "inner" of a loop with domain "domain"
+ * at the given level and return the result.  Sub-lists of loops that
+ * need further scanning are generated, the other loops are kept as is.
+ */
+static CloogLoop *loop_recurse_inner(CloogLoop *inner, CloogDomain *domain,
+	int level, int scalar, int *scaldims, int nb_scattdims,
+	CloogOptions *options)
+{
+    CloogLoop *into, *end, *next, *l, *now;
+
     into = NULL ;
     while (inner != NULL)
     { /* 4b. -ced- recurse for each sub-list of non terminal loops. */
@@ -1762,12 +2388,740 @@ static CloogLoop *loop_recurse(CloogLoop *loop,
       }
     }
 
+    return into;
+}
+
+
+/**
+ * Generate code for the disjoint loops in the list "pieces" at the given
+ * level, each of them containing the loops in "inner" restricted to
+ * its domain, and return the result.  The pieces are not scanned
+ * for strides or split any further at this level.  Pieces that end up
+ * without inner loops are removed.  "inner" is not modified.
+ */
+static CloogLoop *loop_recurse_pieces(CloogLoop *pieces, CloogLoop *inner,
+	int level, int scalar, int *scaldims, int nb_scattdims,
+	CloogOptions *options)
+{
+    CloogLoop *res, *now, *l, *next, *into;
+
+    res = NULL;
+    for (l = pieces; l; l = next) {
+	next = l->next;
+	l->next = NULL;
+	into = cloog_loop_restrict_all_copy(inner, l->domain);
+	if (options->otl)
+	    cloog_loop_otl(l, level);
+	into = loop_recurse_inner(into, l->domain, level, scalar, scaldims,
+				  nb_scattdims, options);
+	if (!into) {
+	    cloog_loop_free_parts(l, 1, 0, 0, 0);
+	    continue;
+	}
+	l->inner = into;
+	cloog_loop_add(&res, &now, l);
+    }
+
+    return res;
+}
+
+
+/**
+ * Return the factor by which a loop containing the loops in the list "loop"
+ * can be unrolled partially, i.e., the smallest factor of all statements
+ * in the list and in their inner loops, or "factor" if that is smaller.
+ * A negative "factor" means that no factor has been found yet.
+ * The factor of statement s is options->unroll_factors[s-1] if it
+ * was specified and options->unroll_factor otherwise.
+ */
+static int cloog_loop_unroll_factor(CloogLoop *loop, int factor,
+	CloogOptions *options)
+{
+    int f;
+    CloogStatement *s;
+
+    for (; loop; loop = loop->next) {
+	if (loop->block)
+	    for (s = loop->block->statement; s; s = s->next) {
+		if (options->unroll_factors &&
+		    s->number <= options->unroll_factors_size)
+		    f = options->unroll_factors[s->number - 1];
+		else
+		    f = options->unroll_factor;
+		if (factor < 0 || f < factor)
+		    factor = f;
+	    }
+	factor = cloog_loop_unroll_factor(loop->inner, factor, options);
+    }
+
+    return factor;
+}
+
+
+/**
+ * Shift the domains of the loops in the list "loop" and of all their
+ * inner loops such that iteration i of the iterator at the given level
+ * becomes iteration i - offset (see cloog_domain_shift).
+ */
+static CloogLoop *cloog_loop_shift(CloogLoop *loop, int level, int offset)
+{
+    CloogLoop *l;
+
+    for (l = loop; l; l = l->next) {
+	l->domain = cloog_domain_shift(l->domain, level, offset);
+	cloog_loop_shift(l->inner, level, offset);
+    }
+
+    return loop;
+}
+
+
+/**
+ * Unroll the given single loop partially by "factor" at the given level.
+ * The loop is split into a main loop with stride "factor", the body of
+ * which contains "factor" copies of the original body, one for each of
+ * the iterations i, i+1, ..., i+factor-1, and remainder loops
+ * that scan the iterations that are not covered by the main loop.
+ * The main loop starts at the first iteration of the original loop if
+ * this iteration has a fixed remainder on division by "factor".
+ * Since the copies of the body are generated one after the other,
+ * the statements are executed in their original order.
+ *
+ * The iterations that are not covered are only known through a modulo
+ * on the iterator, which cannot appear in the bounds of a loop.
+ * The remainder loops therefore scan the last factor-1 iterations of
+ * the original loop and only their inner loops are restricted to the
+ * iterations that are not covered.  They are placed after the main loop,
+ * which is only valid if all the iterations that are not covered are
+ * among these last iterations and follow those of the main loop.
+ *
+ * If the main loop would not perform any iteration or if the remainder
+ * does not satisfy the above conditions, then *unrolled is set to 0
+ * and the loop is returned unchanged.
+ */
+static CloogLoop *loop_unroll_partial(CloogLoop *loop, int factor, int level,
+	int scalar, int *scaldims, int nb_scattdims, CloogOptions *options,
+	int *unrolled)
+{
+    int j, residue, empty, valid;
+    cloog_int_t stride, offset;
+    CloogState *state = loop->state;
+    CloogDomain *blocks, *starts, *first, *covered, *rest, *tail, *domain;
+    CloogDomain *temp;
+    CloogLoop *res, *now, *strided, *copy, *inner, *l;
+
+    /* The iterations i such that i+1, ..., i+factor-1 are iterations too. */
+    blocks = cloog_domain_copy(loop->domain);
+    for (j = 1; j < factor; ++j) {
+	temp = cloog_domain_shift(cloog_domain_copy(loop->domain), level, j);
+	domain = cloog_domain_intersection(blocks, temp);
+	cloog_domain_free(temp);
+	cloog_domain_free(blocks);
+	blocks = domain;
+    }
+
+    /* The remainder of the first iteration, if it is fixed. */
+    temp = cloog_domain_shift(cloog_domain_copy(loop->domain), level, -1);
+    first = cloog_domain_difference(loop->domain, temp);
+    cloog_domain_free(temp);
+    for (residue = 0; residue < factor; ++residue) {
+	temp = cloog_domain_residue(cloog_domain_copy(first), level,
+				    factor, residue);
+	domain = cloog_domain_difference(first, temp);
+	empty = cloog_domain_isempty(domain);
+	cloog_domain_free(domain);
+	cloog_domain_free(temp);
+	if (empty)
+	    break;
+    }
+    cloog_domain_free(first);
+    if (residue == factor)
+	residue = 0;
+
+    starts = cloog_domain_residue(cloog_domain_copy(blocks), level,
+				  factor, residue);
+    if (cloog_domain_isempty(starts)) {
+	cloog_domain_free(starts);
+	cloog_domain_free(blocks);
+	*unrolled = 0;
+	return loop;
+    }
+
+    covered = cloog_domain_copy(starts);
+    for (j = 1; j < factor; ++j) {
+	temp = cloog_domain_shift(cloog_domain_copy(starts), level, -j);
+	covered = cloog_domain_union(covered, temp);
+    }
+    cloog_domain_free(starts);
+    rest = cloog_domain_difference(loop->domain, covered);
+
+    /* The last factor-1 iterations. */
+    temp = cloog_domain_shift(cloog_domain_copy(loop->domain), level,
+			      factor - 1);
+    tail = cloog_domain_difference(loop->domain, temp);
+    cloog_domain_free(temp);
+
+    valid = 1;
+    empty = cloog_domain_isempty(rest);
+    if (!empty) {
+	temp = cloog_domain_difference(rest, tail);
+	valid = cloog_domain_isempty(temp) &&
+		cloog_domain_follows(covered, rest, level) <= 0;
+	cloog_domain_free(temp);
+    }
+    cloog_domain_free(covered);
+    if (!valid) {
+	cloog_domain_free(rest);
+	cloog_domain_free(tail);
+	cloog_domain_free(blocks);
+	*unrolled = 0;
+	return loop;
+    }
+    *unrolled = 1;
+
+    /* The strided loop. */
+    cloog_int_init(stride);
+    cloog_int_init(offset);
+    cloog_int_set_si(stride, factor);
+    cloog_int_set_si(offset, residue);
+    strided = cloog_loop_alloc(state, cloog_domain_copy(blocks), 0, NULL,
+			    NULL, NULL, NULL);
+    strided->stride = cloog_stride_alloc(stride, offset);
+    strided->domain = cloog_domain_stride_lower_bound(strided->domain, level,
+						   strided->stride);
+    cloog_int_clear(stride);
+    cloog_int_clear(offset);
+    if (options->otl)
+	cloog_loop_otl(strided, level);
+
+    domain = cloog_domain_copy(strided->domain);
+    domain = cloog_domain_add_stride_constraint(domain, strided->stride);
+    for (j = 0; j < factor; ++j) {
+	copy = cloog_loop_shift(cloog_loop_copy(loop->inner), level, j);
+	copy = cloog_loop_restrict_all(copy, blocks);
+	inner = loop_recurse_inner(copy, domain, level, scalar, scaldims,
+				   nb_scattdims, options);
+	strided->inner = cloog_loop_concat(strided->inner, inner);
+    }
+    cloog_domain_free(domain);
+    cloog_domain_free(blocks);
+
+    res = NULL;
+    if (strided->inner)
+	cloog_loop_add(&res, &now, strided);
+    else
+	cloog_loop_free(strided);
+
+    /* The remainder loops. */
+    if (!empty) {
+	CloogLoop *pieces = NULL;
+
+	l = cloog_loop_alloc(state, tail, 0, NULL, NULL, NULL, NULL);
+	cloog_loop_add_disjoint(&pieces, &now, l);
+	inner = cloog_loop_restrict_all_copy(loop->inner, rest);
+	l = loop_recurse_pieces(pieces, inner, level, scalar, scaldims,
+				nb_scattdims, options);
+	cloog_loop_free(inner);
+	if (l)
+	    res = cloog_loop_concat(res, cloog_loop_sort(l, level));
+    } else
+	cloog_domain_free(tail);
+    cloog_domain_free(rest);
+
+    cloog_loop_free(loop);
+
+    return res;
+}
+
+
+/**
+ * Return 1 if "domain" can be scanned by a loop at the given level
+ * without a modulo on the iterator at that level, i.e., if removing
+ * the existentially quantified variables that involve this iterator
+ * (as cloog_domain_project does) does not change the domain.
+ */
+static int cloog_domain_is_plain(CloogDomain *domain, int level)
+{
+    int plain;
+    CloogDomain *relaxed, *diff;
+
+    relaxed = cloog_domain_project(domain, level);
+    diff = cloog_domain_difference(relaxed, domain);
+    plain = cloog_domain_isempty(diff);
+    cloog_domain_free(diff);
+    cloog_domain_free(relaxed);
+
+    return plain;
+}
+
+
+/**
+ * Return 1 if no loop in the list starts before the end of a loop
+ * that comes after it in the list at the given level, i.e., if
+ * cloog_loop_sort managed to order the loops.  The relative positions
+ * of the loops can be cyclic, in which case cloog_loop_sort only returns
+ * some order.
+ */
+static int cloog_loop_is_sorted(CloogLoop *loop, int level)
+{
+    CloogLoop *l;
+
+    for (; loop; loop = loop->next)
+	for (l = loop->next; l; l = l->next)
+	    if (cloog_domain_follows(loop->domain, l->domain, level) > 0)
+		return 0;
+
+    return 1;
+}
+
+
+/**
+ * Split the given single loop at the given level into the loops that
+ * scan the full tiles of its inner loops and the loops that scan
+ * the partial tiles (see cloog_domain_partial_tiles).
+ * Since the domain of the loops of the full tiles implies that
+ * the bounds of the original domains are satisfied by the whole tile,
+ * the inner loops of these loops only have the bounds of the tiles.
+ * The inner loops of the resulting loops are generated directly
+ * (see loop_recurse_pieces) and the loops are sorted according
+ * to their position at the given level.
+ *
+ * If all tiles are full or if all tiles are partial, if the loops
+ * of the full or partial tiles would need a modulo on the iterator
+ * at the given level, or if they cannot be ordered, then *split is set
+ * to 0 and the loop is returned unchanged.
+ */
+static CloogLoop *loop_separate_tiles(CloogLoop *loop, int level,
+	int scalar, int *scaldims, int nb_scattdims, CloogOptions *options,
+	int *split)
+{
+    CloogState *state = loop->state;
+    CloogDomain *partial, *full, *temp;
+    CloogLoop *res, *pieces, *now, *l;
+
+    partial = cloog_domain_empty(loop->domain);
+    for (l = loop->inner; l; l = l->next) {
+	temp = cloog_domain_partial_tiles(l->domain, level);
+	partial = cloog_domain_union(partial, temp);
+    }
+    temp = cloog_domain_intersection(partial, loop->domain);
+    cloog_domain_free(partial);
+    partial = temp;
+    full = cloog_domain_difference(loop->domain, partial);
+
+    if (cloog_domain_isempty(partial) || cloog_domain_isempty(full) ||
+	!cloog_domain_is_plain(partial, level) ||
+	!cloog_domain_is_plain(full, level)) {
+	cloog_domain_free(partial);
+	cloog_domain_free(full);
+	*split = 0;
+	return loop;
+    }
+
+    pieces = NULL;
+    l = cloog_loop_alloc(state, full, 0, NULL, NULL, NULL, NULL);
+    cloog_loop_add_disjoint(&pieces, &now, l);
+    l = cloog_loop_alloc(state, partial, 0, NULL, NULL, NULL, NULL);
+    cloog_loop_add_disjoint(&pieces, &now, l);
+
+    pieces = cloog_loop_sort(pieces, level);
+    if (!cloog_loop_is_sorted(pieces, level)) {
+	cloog_loop_free(pieces);
+	*split = 0;
+	return loop;
+    }
+    *split = 1;
+
+    res = loop_recurse_pieces(pieces, loop->inner, level, scalar, scaldims,
+			      nb_scattdims, options);
+
+    cloog_loop_free(loop);
+
+    return res;
+}
+
+
+/**
+ * Recurse on the inner loops of the given single loop.
+ *
+ * - loop is the loop for which we have to generate scanning code,
+ * - level is the current non-scalar dimension,
+ * - scalar is the current scalar dimension,
+ * - scaldims is the boolean array saying whether a dimension is scalar or not,
+ * - nb_scattdims is the size of the scaldims array,
+ * - constant is true if the loop is known to be executed at most once
+ * - options are the general code generation options.
+ */
+static CloogLoop *loop_recurse(CloogLoop *loop,
+	int level, int scalar, int *scaldims, int nb_scattdims,
+	int constant, CloogOptions *options)
+{
+    CloogLoop *into;
+    CloogDomain *domain;
+
+    if (level && options->strides && !constant)
+      cloog_loop_stride(loop, level);
+
+    if (!constant &&
+	options->first_unroll >= 0 && level + scalar >= options->first_unroll) {
+	loop = cloog_loop_unroll(loop, level);
+	if (loop->next)
+	    return cloog_loop_recurse(loop, level, scalar, scaldims,
+					nb_scattdims, 1, options);
+    }
+
+    if (!constant && level && !loop->stride && !loop->block &&
+	options->full_tiles == level + scalar) {
+	int split;
+	loop = loop_separate_tiles(loop, level, scalar, scaldims,
+				   nb_scattdims, options, &split);
+	if (split)
+	    return loop;
+    }
+
+    if (!constant && level && !loop->stride && !loop->block &&
+	options->unroll_depth == level + scalar &&
+	level + scalar <= nb_scattdims) {
+	int factor, unrolled;
+	factor = cloog_loop_unroll_factor(loop->inner, -1, options);
+	if (factor > 1) {
+	    loop = loop_unroll_partial(loop, factor, level, scalar, scaldims,
+					nb_scattdims, options, &unrolled);
+	    if (unrolled)
+		return loop;
+	}
+    }
+
+    if (level && options->otl)
+      cloog_loop_otl(loop, level);
+    domain = cloog_domain_copy(loop->domain);
+    domain = cloog_domain_add_stride_constraint(domain, loop->stride);
+    into = loop_recurse_inner(loop->inner, domain, level, scalar, scaldims,
+			      nb_scattdims, options);
     cloog_domain_free(domain);
+
+    /* Cut the loop if nothing is left inside it. */
+    if (!into && !loop->block) {
+	cloog_loop_free_parts(loop, 1, 0, 0, 0);
+	return NULL;
+    }
+
     loop->inner = into;
     return loop;
 }
 
 
+/* Correspondence between the blocks in the state of the caller
+ * and their copies in the state of a worker thread or in the components
+ * kept by the state of the caller.
+ * Both "orig" and "copy" hold a reference to the corresponding block.
+ */
+struct cloog_block_map {
+    int n;
+    int size;
+    CloogBlock **orig;
+    CloogBlock **copy;
+};
+
+/* Return a copy of "block" in "state", reusing the copy that was
+ * made earlier for the same block, if any.
+ */
+static CloogBlock *block_transfer_in(struct cloog_block_map *map,
+	CloogBlock *block, CloogState *state)
+{
+    int i;
+    CloogBlock *copy;
+    CloogStatement *s, **next;
+
+    if (!block)
+	return NULL;
+
+    for (i = 0; i < map->n; ++i)
+	if (map->orig[i] == block)
+	    return cloog_block_copy(map->copy[i]);
+
+    copy = cloog_block_malloc(state);
+    next = &copy->statement;
+    for (s = block->statement; s; s = s->next) {
+	*next = cloog_statement_alloc(state, s->number);
+	(*next)->name = s->name ? strdup(s->name) : NULL;
+	(*next)->usr = s->usr;
+	next = &(*next)->next;
+    }
+    copy->nb_scaldims = block->nb_scaldims;
+    if (block->nb_scaldims) {
+	copy->scaldims = (cloog_int_t *)malloc(block->nb_scaldims *
+						sizeof(cloog_int_t));
+	if (!copy->scaldims)
+	    cloog_die("memory overflow.\n");
+	for (i = 0; i < block->nb_scaldims; ++i) {
+	    cloog_int_init(copy->scaldims[i]);
+	    cloog_int_set(copy->scaldims[i], block->scaldims[i]);
+	}
+    }
+    copy->depth = block->depth;
+    copy->usr = block->usr;
+
+    if (map->n == map->size) {
+	map->size = 2 * map->size + 4;
+	map->orig = (CloogBlock **)realloc(map->orig,
+					map->size * sizeof(CloogBlock *));
+	map->copy = (CloogBlock **)realloc(map->copy,
+					map->size * sizeof(CloogBlock *));
+	if (!map->orig || !map->copy)
+	    cloog_die("memory overflow.\n");
+    }
+    map->orig[map->n] = cloog_block_copy(block);
+    map->copy[map->n] = copy;
+    map->n++;
+
+    return cloog_block_copy(copy);
+}
+
+static void cloog_block_map_free(struct cloog_block_map *map)
+{
+    int i;
+
+    for (i = 0; i < map->n; ++i) {
+	cloog_block_free(map->orig[i]);
+	cloog_block_free(map->copy[i]);
+    }
+    free(map->orig);
+    free(map->copy);
+}
+
+#ifdef CLOOG_PTHREADS
+
+/* A list of loops that is handled by a worker thread.
+ * The loops live in their own CloogState (and therefore their own
+ * isl_ctx) since an isl_ctx cannot be used from several threads
+ * at the same time.
+ */
+struct cloog_loop_task {
+    CloogState *state;
+    CloogOptions options;
+    CloogLoop *loop;
+    struct cloog_block_map map;
+};
+
+/* A set of independent tasks, each of which applies "fn"
+ * to the loops of the task.  The remaining fields are the arguments
+ * of the code generation functions called by "fn".
+ */
+struct cloog_loop_tasks {
+    pthread_mutex_t lock;
+    int next;
+    int n;
+    struct cloog_loop_task *task;
+    CloogLoop *(*fn)(CloogLoop *loop, struct cloog_loop_tasks *tasks,
+			CloogOptions *options);
+    int level;
+    int scalar;
+    int *scaldims;
+    int nb_scattdims;
+    int constant;
+};
+
+/* Return the original block of which "block" is a copy.
+ * Code generation only ever shares blocks, so every block in
+ * the result of a worker is the copy of some original block.
+ */
+static CloogBlock *block_transfer_out(struct cloog_block_map *map,
+	CloogBlock *block)
+{
+    int i;
+
+    if (!block)
+	return NULL;
+
+    for (i = 0; i < map->n; ++i)
+	if (map->copy[i] == block)
+	    return cloog_block_copy(map->orig[i]);
+
+    assert(0);
+    return NULL;
+}
+
+/* Copy the list of loops "loop" (and all their inner loops) into "state".
+ * If "in" is set, then the blocks are copied into "state" as well,
+ * otherwise they are mapped back to the original blocks.
+ * The loops are not supposed to have any strides.
+ */
+static CloogLoop *cloog_loop_transfer(CloogLoop *loop, CloogState *state,
+	struct cloog_block_map *map, int in)
+{
+    CloogLoop *res = NULL, **next = &res;
+
+    for (; loop; loop = loop->next) {
+	assert(!loop->stride);
+	*next = cloog_loop_malloc(state);
+	(*next)->domain = cloog_domain_transfer(loop->domain, state);
+	(*next)->unsimplified = cloog_domain_transfer(loop->unsimplified,
+							state);
+	(*next)->otl = loop->otl;
+	(*next)->usr = loop->usr;
+	if (in)
+	    (*next)->block = block_transfer_in(map, loop->block, state);
+	else
+	    (*next)->block = block_transfer_out(map, loop->block);
+	(*next)->inner = cloog_loop_transfer(loop->inner, state, map, in);
+	next = &(*next)->next;
+    }
+
+    return res;
+}
+
+/* Add the memory allocation counters of "worker" to those of "state".
+ * The structures of the worker are alive at the same time as
+ * those of "state", so its maxima are added to the current
+ * number of live structures in "state".
+ */
+static void cloog_state_add_counters(CloogState *state, CloogState *worker)
+{
+    int live;
+
+    live = state->block_allocated - state->block_freed;
+    if (live + worker->block_max > state->block_max)
+	state->block_max = live + worker->block_max;
+    state->block_allocated += worker->block_allocated;
+    state->block_freed += worker->block_freed;
+
+    live = state->domain_allocated - state->domain_freed;
+    if (live + worker->domain_max > state->domain_max)
+	state->domain_max = live + worker->domain_max;
+    state->domain_allocated += worker->domain_allocated;
+    state->domain_freed += worker->domain_freed;
+
+    live = state->loop_allocated - state->loop_freed;
+    if (live + worker->loop_max > state->loop_max)
+	state->loop_max = live + worker->loop_max;
+    state->loop_allocated += worker->loop_allocated;
+    state->loop_freed += worker->loop_freed;
+
+    live = state->statement_allocated - state->statement_freed;
+    if (live + worker->statement_max > state->statement_max)
+	state->statement_max = live + worker->statement_max;
+    state->statement_allocated += worker->statement_allocated;
+    state->statement_freed += worker->statement_freed;
+
+    state->memo_hits += worker->memo_hits;
+    state->memo_misses += worker->memo_misses;
+}
+
+/* Worker thread: take the next task until there are none left.
+ */
+static void *cloog_loop_tasks_worker(void *user)
+{
+    struct cloog_loop_tasks *tasks = user;
+    struct cloog_loop_task *task;
+    int i;
+
+    for (;;) {
+	pthread_mutex_lock(&tasks->lock);
+	i = tasks->next++;
+	pthread_mutex_unlock(&tasks->lock);
+	if (i >= tasks->n)
+	    break;
+	task = &tasks->task[i];
+	task->loop = tasks->fn(task->loop, tasks, &task->options);
+    }
+
+    return NULL;
+}
+
+/* Apply tasks->fn to each of the "n" lists of loops in "loops" using
+ * options->threads threads (including the calling thread) and
+ * return the concatenation of the results, in the order of the lists.
+ * Each list is first copied into a fresh CloogState.
+ * All copying between states is performed by the calling thread
+ * so that no isl_ctx is ever accessed from two threads at once.
+ * The tasks are taken by the threads in order as soon as they become idle,
+ * so that a few large tasks do not keep the other threads waiting.
+ * If some threads cannot be created, the remaining threads
+ * simply handle more tasks.
+ * Each task counts its isl operations against options->max_operations
+ * on its own and the cheapest strategy used by any task is reported
+ * in options->fallback.
+ */
+static CloogLoop *cloog_loop_parallel(CloogLoop **loops, int n,
+	struct cloog_loop_tasks *tasks, CloogOptions *options)
+{
+    int i, nb_threads;
+    pthread_t *threads;
+    CloogState *state = loops[0]->state;
+    CloogLoop *res = NULL, **res_next = &res;
+
+    nb_threads = (options->threads < n ? options->threads : n) - 1;
+    threads = (pthread_t *)malloc(nb_threads * sizeof(pthread_t));
+    tasks->task = (struct cloog_loop_task *)
+		    malloc(n * sizeof(struct cloog_loop_task));
+    if (!threads || !tasks->task)
+	cloog_die("memory overflow.\n");
+
+    tasks->next = 0;
+    tasks->n = n;
+    for (i = 0; i < n; ++i) {
+	struct cloog_loop_task *task = &tasks->task[i];
+	task->state = cloog_state_malloc();
+	if (state->arena)
+	    cloog_state_use_arena(task->state);
+	task->state->memo_size = state->memo_size;
+	task->options = *options;
+	task->options.state = task->state;
+	task->options.threads = 1;
+	cloog_state_set_max_operations(task->state, options->max_operations);
+	task->map.n = task->map.size = 0;
+	task->map.orig = task->map.copy = NULL;
+	task->loop = cloog_loop_transfer(loops[i], task->state,
+					&task->map, 1);
+	cloog_loop_free(loops[i]);
+    }
+
+    pthread_mutex_init(&tasks->lock, NULL);
+    for (i = 0; i < nb_threads; ++i)
+	if (pthread_create(&threads[i], NULL, &cloog_loop_tasks_worker, tasks))
+	    break;
+    nb_threads = i;
+    cloog_loop_tasks_worker(tasks);
+    for (i = 0; i < nb_threads; ++i)
+	pthread_join(threads[i], NULL);
+    pthread_mutex_destroy(&tasks->lock);
+
+    for (i = 0; i < n; ++i) {
+	struct cloog_loop_task *task = &tasks->task[i];
+	*res_next = cloog_loop_transfer(task->loop, state, &task->map, 0);
+	while (*res_next)
+	    res_next = &(*res_next)->next;
+	cloog_loop_free(task->loop);
+	cloog_block_map_free(&task->map);
+	if (task->options.fallback > options->fallback)
+	    options->fallback = task->options.fallback;
+	cloog_state_add_counters(state, task->state);
+	cloog_state_free(task->state);
+    }
+
+    free(tasks->task);
+    free(threads);
+
+    return res;
+}
+
+static CloogLoop *task_generate_general(CloogLoop *loop,
+	struct cloog_loop_tasks *tasks, CloogOptions *options)
+{
+    return cloog_loop_generate_general(loop, tasks->level, tasks->scalar,
+			tasks->scaldims, tasks->nb_scattdims, options);
+}
+
+static CloogLoop *task_recurse(CloogLoop *loop,
+	struct cloog_loop_tasks *tasks, CloogOptions *options)
+{
+    return loop_recurse(loop, tasks->level, tasks->scalar, tasks->scaldims,
+			tasks->nb_scattdims, tasks->constant, options);
+}
+
+#endif
+
 /**
  * Recurse on the inner loops of each of the loops in the loop list.
  *
@@ -1778,6 +3132,12 @@ static CloogLoop *loop_recurse(CloogLoop *loop,
  * - nb_scattdims is the size of the scaldims array,
  * - constant is true if the loop is known to be executed at most once
  * - options are the general code generation options.
+ *
+ * The loops in the list have disjoint domains and their inner lists
+ * are independent of each other, so if the user asked for several threads,
+ * the loops up to depth options->threads_depth are handled in parallel.
+ * Deeper loops typically have smaller inner lists and are handled
+ * sequentially.
  */
 CloogLoop *cloog_loop_recurse(CloogLoop *loop,
 	int level, int scalar, int *scaldims, int nb_scattdims,
@@ -1787,6 +3147,36 @@ CloogLoop *cloog_loop_recurse(CloogLoop *loop,
     CloogLoop *res = NULL;
     CloogLoop **next_res = &res;
 
+#ifdef CLOOG_PTHREADS
+    if (options->threads > 1 && !cloog_loop_may_stride(options) &&
+	loop && loop->next &&
+	(options->threads_depth < 0 || level <= options->threads_depth)) {
+	int i, n;
+	CloogLoop **loops;
+	struct cloog_loop_tasks tasks;
+
+	n = cloog_loop_count(loop);
+	loops = (CloogLoop **)malloc(n * sizeof(CloogLoop *));
+	assert(loops);
+	for (i = 0, now = loop; now; now = next, ++i) {
+	    next = now->next;
+	    now->next = NULL;
+	    loops[i] = now;
+	}
+
+	tasks.fn = &task_recurse;
+	tasks.level = level;
+	tasks.scalar = scalar;
+	tasks.scaldims = scaldims;
+	tasks.nb_scattdims = nb_scattdims;
+	tasks.constant = constant;
+	res = cloog_loop_parallel(loops, n, &tasks, options);
+	free(loops);
+
+	return res;
+    }
+#endif
+
     for (now = loop; now; now = next) {
 	next = now->next;
 	now->next = NULL;
@@ -1875,6 +3265,8 @@ CloogLoop *cloog_loop_generate_general(CloogLoop *loop,
   CloogLoop *res, *now, *temp, *l, *new_loop, *next;
   int separate = 0;
   int constant = 0;
+  int exceeded = 0;
+  int fallback;
 
     int first = -1;
     int last = -1;
@@ -1890,6 +3282,17 @@ CloogLoop *cloog_loop_generate_general(CloogLoop *loop,
         last = options->l;
     }
 
+    /* With a size budget, separation is tried at every depth and
+     * cloog_loop_separate_budget decides whether it is worth it.
+     */
+    if (options->size_budget >= 0)
+        first = 1;
+
+    /* Cheaper strategies if we are running out of isl operations. */
+    fallback = cloog_loop_fallback(loop->state, options);
+    if (fallback >= CLOOG_FALLBACK_MERGE)
+	first = -1;
+
   /* 3. Separate all projections into disjoint polyhedra. */
   if (level > 0 && cloog_loop_is_constant(loop, level)) {
     res = cloog_loop_constant(loop, level);
@@ -1897,9 +3300,29 @@ CloogLoop *cloog_loop_generate_general(CloogLoop *loop,
     }else if ((first > level+scalar) || (first < 0)) {
     res = cloog_loop_merge(loop, level, options);
     }else{
-    res = cloog_loop_separate(loop);
+    res = cloog_loop_separate_budget(loop, options, &exceeded);
     separate = 1;
+    if ((exceeded == 2) ||
+        (exceeded && options->fallback >= CLOOG_FALLBACK_MERGE)) {
+      res = cloog_loop_merge(res, level, options);
+      separate = 0;
+    } else if (exceeded) {
+      cloog_msg(options, CLOOG_WARNING,
+		"separation at depth %d needs more than %d polyhedra, "
+		"loops are\n                merged instead.\n",
+		level + scalar, options->separate_budget);
+      res = cloog_loop_merge(res, level, options);
+      separate = 0;
+    }
   }
+
+  /* 3a. Remove the polyhedra without integral points right away rather
+   *     than generating code for them that cloog_loop_simplify would
+   *     remove afterwards.
+   */
+  res = cloog_loop_remove_never_integral_loops(res);
+  if (!res)
+    return NULL;
     
   /* 3b. -correction- sort the loops to determine their textual order. */
   res = cloog_loop_sort(res, level);
@@ -1935,10 +3358,15 @@ CloogLoop *cloog_loop_generate_general(CloogLoop *loop,
    *    the example called linearity-1-1 example with and without this part
    *    for an idea.
    */
-  if (options->backtrack && level &&
+  if ((options->backtrack || options->hoist) &&
+            (fallback == CLOOG_FALLBACK_NONE) && level &&
             ((level+scalar < last) || (last < 0)) &&
-            ((first <= level+scalar) && !(first < 0)))
-  res = cloog_loop_generate_backtrack(res, level, options);
+            ((first <= level+scalar) && !(first < 0))) {
+    if (options->hoist)
+      res = cloog_loop_hoist_guards(res, level);
+    else
+      res = cloog_loop_generate_backtrack(res, level, options);
+  }
   
   /* Pray for my new paper to be accepted somewhere since the following stuff
    * is really amazing :-) !
@@ -2185,8 +3613,8 @@ int cloog_loop_follows(CloogLoop *loop1, CloogLoop *loop2,
 		return 0;
 	    scalar += scaldims[level + scalar - 1];
 	} else {
-	    int follows = cloog_domain_follows(loop1->domain, loop2->domain,
-						level);
+	    int follows = cloog_domain_follows_cached(loop1->state,
+				    loop1->domain, loop2->domain, level);
 	    if (follows > 0)
 		return 1;
 	    if (follows < 0)
@@ -2389,6 +3817,509 @@ static int extract_component(CloogLoop **loop_array, int *list, CloogLoop **res)
 }
 
 
+/* Components generated by cloog_loop_generate_general that are kept
+ * by a CloogState for later calls on the same state
+ * (see cloog_state_reuse_components).
+ * Each entry holds a private copy of the component ("input") and
+ * of the loops generated from it ("output"), such that the blocks
+ * of the copies are not shared with the caller, along with the string
+ * representations of the "n" domains of the component, in pre-order.
+ * The domains themselves cannot be compared since isl may change
+ * their representation in place after they have been kept.
+ * The entries are found through a hash table on a hash of the component
+ * and are dropped in order of last use once there are
+ * CLOOG_COMPONENTS_MAX of them.
+ * All entries have been generated with the same scalar dimensions and
+ * options, which are kept in the remaining fields.
+ */
+#define CLOOG_COMPONENTS_BUCKETS	1024
+#define CLOOG_COMPONENTS_MAX		16384
+
+struct cloog_component {
+    unsigned hash;
+    int level;
+    int scalar;
+    CloogLoop *input;
+    CloogLoop *output;
+    int n;
+    char **domains;
+    struct cloog_component *next;
+    struct cloog_component *newer;
+    struct cloog_component *older;
+};
+
+struct cloogcomponents {
+    int n;
+    struct cloog_component *bucket[CLOOG_COMPONENTS_BUCKETS];
+    struct cloog_component *newest;
+    struct cloog_component *oldest;
+
+    int nb_scattdims;
+    int *scaldims;
+    CloogOptions options;
+};
+
+CloogComponents *cloog_loop_components_alloc(void)
+{
+    CloogComponents *components;
+
+    components = (CloogComponents *)calloc(1, sizeof(CloogComponents));
+    if (!components)
+	cloog_die("memory overflow.\n");
+    components->nb_scattdims = -1;
+
+    return components;
+}
+
+static void cloog_component_free(struct cloog_component *c)
+{
+    int i;
+
+    cloog_loop_free(c->input);
+    cloog_loop_free(c->output);
+    for (i = 0; i < c->n; ++i)
+	free(c->domains[i]);
+    free(c->domains);
+    free(c);
+}
+
+static void cloog_loop_components_clear(CloogComponents *components)
+{
+    struct cloog_component *c, *next;
+
+    for (c = components->newest; c; c = next) {
+	next = c->older;
+	cloog_component_free(c);
+    }
+    memset(components->bucket, 0, sizeof(components->bucket));
+    components->newest = NULL;
+    components->oldest = NULL;
+    components->n = 0;
+
+    free(components->scaldims);
+    free(components->options.fs);
+    free(components->options.ls);
+    components->scaldims = NULL;
+    components->options.fs = NULL;
+    components->options.ls = NULL;
+    components->nb_scattdims = -1;
+}
+
+void cloog_loop_components_free(CloogComponents *components)
+{
+    if (!components)
+	return;
+
+    cloog_loop_components_clear(components);
+    free(components);
+}
+
+static int *cloog_int_array_dup(int *array, int n)
+{
+    int *dup;
+
+    if (!array)
+	return NULL;
+    dup = (int *)malloc(n * sizeof(int));
+    if (!dup)
+	cloog_die("memory overflow.\n");
+    memcpy(dup, array, n * sizeof(int));
+
+    return dup;
+}
+
+static int cloog_int_array_equal(int *array1, int *array2, int n)
+{
+    if (!array1 || !array2)
+	return array1 == array2;
+    return !memcmp(array1, array2, n * sizeof(int));
+}
+
+/* Make sure all components kept in "components" have been generated
+ * with the scalar dimensions "scaldims" and the options "options",
+ * dropping them if they were generated with different ones.
+ * Only the options that affect cloog_loop_generate_general are compared.
+ */
+static void cloog_loop_components_check(CloogComponents *components,
+	int *scaldims, int nb_scattdims, CloogOptions *options)
+{
+    CloogOptions *kept = &components->options;
+
+    if (components->nb_scattdims == nb_scattdims &&
+	cloog_int_array_equal(components->scaldims, scaldims, nb_scattdims) &&
+	kept->l == options->l && kept->f == options->f &&
+	kept->fs_ls_size == options->fs_ls_size &&
+	cloog_int_array_equal(kept->fs, options->fs, options->fs_ls_size) &&
+	cloog_int_array_equal(kept->ls, options->ls, options->fs_ls_size) &&
+	kept->stop == options->stop && kept->sh == options->sh &&
+	kept->first_unroll == options->first_unroll &&
+	kept->full_tiles == options->full_tiles &&
+	kept->otl == options->otl && kept->backtrack == options->backtrack &&
+	kept->hoist == options->hoist &&
+	kept->separate_budget == options->separate_budget &&
+	kept->size_budget == options->size_budget)
+	return;
+
+    cloog_loop_components_clear(components);
+    components->nb_scattdims = nb_scattdims;
+    components->scaldims = cloog_int_array_dup(scaldims, nb_scattdims);
+    kept->l = options->l;
+    kept->f = options->f;
+    kept->fs_ls_size = options->fs_ls_size;
+    kept->fs = cloog_int_array_dup(options->fs, options->fs_ls_size);
+    kept->ls = cloog_int_array_dup(options->ls, options->fs_ls_size);
+    kept->stop = options->stop;
+    kept->sh = options->sh;
+    kept->first_unroll = options->first_unroll;
+    kept->full_tiles = options->full_tiles;
+    kept->otl = options->otl;
+    kept->backtrack = options->backtrack;
+    kept->hoist = options->hoist;
+    kept->separate_budget = options->separate_budget;
+    kept->size_budget = options->size_budget;
+}
+
+/* Return the number of loops in the list "loop" and all their inner loops.
+ */
+static int cloog_loop_count_all(CloogLoop *loop)
+{
+    int n = 0;
+
+    for (; loop; loop = loop->next)
+	n += 1 + cloog_loop_count_all(loop->inner);
+
+    return n;
+}
+
+/* Store the string representations of the domains of the loops
+ * in the list "loop" and all their inner loops in pre-order
+ * in "domains", starting at position "n".
+ * Return the position after the last domain.
+ */
+static int cloog_loop_component_domains(CloogLoop *loop, char **domains,
+	int n)
+{
+    for (; loop; loop = loop->next) {
+	domains[n++] = cloog_domain_to_str(loop->domain);
+	n = cloog_loop_component_domains(loop->inner, domains, n);
+    }
+
+    return n;
+}
+
+/* Return a hash of the list of loops "loop" (and all their inner loops)
+ * with domains "domains" that only depends on these domains,
+ * the otl flags of the loops and the numbers of their statements.
+ */
+static unsigned cloog_loop_component_hash(CloogLoop *loop, char **domains,
+	int n)
+{
+    int i;
+    unsigned hash = 0;
+    const char *c;
+    CloogStatement *s;
+
+    for (i = 0; i < n; ++i)
+	for (c = domains[i]; *c; ++c)
+	    hash = 31 * hash + *c;
+
+    for (; loop; loop = loop->next) {
+	hash = 31 * hash + loop->otl;
+	if (loop->block)
+	    for (s = loop->block->statement; s; s = s->next)
+		hash = 31 * hash + s->number;
+	hash = 31 * hash + cloog_loop_component_hash(loop->inner, NULL, 0);
+    }
+
+    return hash;
+}
+
+/* Do "block1" and "block2" contain the same statements
+ * at the same scalar dimensions and depth?
+ */
+static int cloog_block_same(CloogBlock *block1, CloogBlock *block2)
+{
+    int i;
+    CloogStatement *s1, *s2;
+
+    if (!block1 || !block2)
+	return block1 == block2;
+
+    for (s1 = block1->statement, s2 = block2->statement; s1 && s2;
+	    s1 = s1->next, s2 = s2->next)
+	if (s1->number != s2->number)
+	    return 0;
+    if (s1 || s2)
+	return 0;
+
+    if (block1->nb_scaldims != block2->nb_scaldims ||
+	block1->depth != block2->depth)
+	return 0;
+    for (i = 0; i < block1->nb_scaldims; ++i)
+	if (cloog_int_ne(block1->scaldims[i], block2->scaldims[i]))
+	    return 0;
+
+    return 1;
+}
+
+/* Do the lists of loops "loop1" and "loop2" have the same structure,
+ * otl flags and blocks?
+ */
+static int cloog_loop_same(CloogLoop *loop1, CloogLoop *loop2)
+{
+    for (; loop1 && loop2; loop1 = loop1->next, loop2 = loop2->next) {
+	if (loop1->otl != loop2->otl || loop1->stride || loop2->stride)
+	    return 0;
+	if (!cloog_block_same(loop1->block, loop2->block))
+	    return 0;
+	if (!cloog_loop_same(loop1->inner, loop2->inner))
+	    return 0;
+    }
+
+    return !loop1 && !loop2;
+}
+
+/* Copy the list of loops "loop" (and all their inner loops)
+ * within their state, except that the blocks are copied as well.
+ * The loops are not supposed to have any strides.
+ */
+static CloogLoop *cloog_loop_copy_private(CloogLoop *loop,
+	struct cloog_block_map *map)
+{
+    CloogLoop *res = NULL, **next = &res;
+
+    for (; loop; loop = loop->next) {
+	assert(!loop->stride);
+	*next = cloog_loop_malloc(loop->state);
+	(*next)->domain = cloog_domain_copy(loop->domain);
+	if (loop->unsimplified)
+	    (*next)->unsimplified = cloog_domain_copy(loop->unsimplified);
+	(*next)->otl = loop->otl;
+	(*next)->usr = loop->usr;
+	(*next)->block = block_transfer_in(map, loop->block, loop->state);
+	(*next)->inner = cloog_loop_copy_private(loop->inner, map);
+	next = &(*next)->next;
+    }
+
+    return res;
+}
+
+/* A statement of a component along with the block it belongs to.
+ */
+struct cloog_statement_in_block {
+    CloogStatement *statement;
+    CloogBlock *block;
+};
+
+static int cloog_statement_in_block_cmp(const void *p1, const void *p2)
+{
+    const struct cloog_statement_in_block *s1 = p1;
+    const struct cloog_statement_in_block *s2 = p2;
+
+    return s1->statement->number - s2->statement->number;
+}
+
+static int cloog_loop_collect_statements(CloogLoop *loop,
+	struct cloog_statement_in_block *list, int n)
+{
+    CloogStatement *s;
+
+    for (; loop; loop = loop->next) {
+	if (loop->block)
+	    for (s = loop->block->statement; s; s = s->next) {
+		list[n].statement = s;
+		list[n].block = loop->block;
+		n++;
+	    }
+	n = cloog_loop_collect_statements(loop->inner, list, n);
+    }
+
+    return n;
+}
+
+static int cloog_loop_count_statements(CloogLoop *loop)
+{
+    int n = 0;
+    CloogStatement *s;
+
+    for (; loop; loop = loop->next) {
+	if (loop->block)
+	    for (s = loop->block->statement; s; s = s->next)
+		n++;
+	n += cloog_loop_count_statements(loop->inner);
+    }
+
+    return n;
+}
+
+/* Give the blocks copied into "map" the names and user data of
+ * the statements and blocks of "loop", the component of the current call
+ * that is the same as the component from which the blocks were generated.
+ */
+static void cloog_loop_components_restore(struct cloog_block_map *map,
+	CloogLoop *loop)
+{
+    int i, n;
+    CloogStatement *s;
+    struct cloog_statement_in_block *list, key, *found;
+
+    n = cloog_loop_count_statements(loop);
+    list = (struct cloog_statement_in_block *)
+		malloc(n * sizeof(struct cloog_statement_in_block));
+    if (n && !list)
+	cloog_die("memory overflow.\n");
+    cloog_loop_collect_statements(loop, list, 0);
+    qsort(list, n, sizeof(*list), cloog_statement_in_block_cmp);
+
+    for (i = 0; i < map->n; ++i) {
+	for (s = map->copy[i]->statement; s; s = s->next) {
+	    key.statement = s;
+	    found = bsearch(&key, list, n, sizeof(*list),
+			    cloog_statement_in_block_cmp);
+	    if (!found)
+		continue;
+	    if (s == map->copy[i]->statement)
+		map->copy[i]->usr = found->block->usr;
+	    free(s->name);
+	    s->name = found->statement->name ?
+			strdup(found->statement->name) : NULL;
+	    s->usr = found->statement->usr;
+	}
+    }
+
+    free(list);
+}
+
+static void cloog_loop_components_unlink(CloogComponents *components,
+	struct cloog_component *c)
+{
+    if (c->newer)
+	c->newer->older = c->older;
+    else
+	components->newest = c->older;
+    if (c->older)
+	c->older->newer = c->newer;
+    else
+	components->oldest = c->newer;
+}
+
+static void cloog_loop_components_touch(CloogComponents *components,
+	struct cloog_component *c)
+{
+    c->newer = NULL;
+    c->older = components->newest;
+    if (components->newest)
+	components->newest->newer = c;
+    else
+	components->oldest = c;
+    components->newest = c;
+}
+
+static void cloog_loop_components_drop_oldest(CloogComponents *components)
+{
+    struct cloog_component *c = components->oldest, **p;
+
+    cloog_loop_components_unlink(components, c);
+    p = &components->bucket[c->hash % CLOOG_COMPONENTS_BUCKETS];
+    while (*p != c)
+	p = &(*p)->next;
+    *p = c->next;
+    cloog_component_free(c);
+    components->n--;
+}
+
+/**
+ * Call cloog_loop_generate_general on the strongly connected component
+ * "loop", unless the state of "loop" keeps the components it generates
+ * and an identical component was generated before, in which case
+ * a copy of the loops generated back then is returned instead.
+ * Components with strides are not kept since strides cannot be copied
+ * and neither are components generated under a budget of isl operations
+ * since the loops generated from them depend on the operations performed
+ * before.
+ */
+static CloogLoop *cloog_loop_generate_component(CloogLoop *loop,
+	int level, int scalar, int *scaldims, int nb_scattdims,
+	CloogOptions *options)
+{
+    int i, n;
+    char **domains;
+    unsigned hash;
+    CloogLoop *res;
+    CloogComponents *components = loop->state->components;
+    struct cloog_component *c;
+    struct cloog_block_map map = { 0, 0, NULL, NULL };
+
+    if (!components || cloog_loop_may_stride(options) ||
+	options->max_operations >= 0)
+	return cloog_loop_generate_general(loop, level, scalar,
+					     scaldims, nb_scattdims, options);
+
+    cloog_loop_components_check(components, scaldims, nb_scattdims, options);
+
+    n = cloog_loop_count_all(loop);
+    domains = (char **)malloc(n * sizeof(char *));
+    if (!domains)
+	cloog_die("memory overflow.\n");
+    cloog_loop_component_domains(loop, domains, 0);
+
+    hash = cloog_loop_component_hash(loop, domains, n);
+    hash = 31 * (31 * hash + level) + scalar;
+    for (c = components->bucket[hash % CLOOG_COMPONENTS_BUCKETS]; c;
+	    c = c->next) {
+	if (c->hash != hash || c->level != level || c->scalar != scalar ||
+	    c->n != n)
+	    continue;
+	for (i = 0; i < n; ++i)
+	    if (strcmp(c->domains[i], domains[i]))
+		break;
+	if (i == n && cloog_loop_same(c->input, loop))
+	    break;
+    }
+
+    if (c) {
+	for (i = 0; i < n; ++i)
+	    free(domains[i]);
+	free(domains);
+	cloog_loop_components_unlink(components, c);
+	cloog_loop_components_touch(components, c);
+	res = cloog_loop_copy_private(c->output, &map);
+	cloog_loop_components_restore(&map, loop);
+	cloog_block_map_free(&map);
+	cloog_loop_free(loop);
+	return res;
+    }
+
+    c = (struct cloog_component *)malloc(sizeof(struct cloog_component));
+    if (!c)
+	cloog_die("memory overflow.\n");
+    c->hash = hash;
+    c->level = level;
+    c->scalar = scalar;
+    c->n = n;
+    c->domains = domains;
+    c->input = cloog_loop_copy_private(loop, &map);
+    cloog_block_map_free(&map);
+    res = cloog_loop_generate_general(loop, level, scalar,
+					scaldims, nb_scattdims, options);
+    map.n = 0;
+    map.size = 0;
+    map.orig = NULL;
+    map.copy = NULL;
+    c->output = cloog_loop_copy_private(res, &map);
+    cloog_block_map_free(&map);
+
+    if (components->n >= CLOOG_COMPONENTS_MAX)
+	cloog_loop_components_drop_oldest(components);
+    c->next = components->bucket[hash % CLOOG_COMPONENTS_BUCKETS];
+    components->bucket[hash % CLOOG_COMPONENTS_BUCKETS] = c;
+    cloog_loop_components_touch(components, c);
+    components->n++;
+
+    return res;
+}
+
+
 /**
  * Call cloog_loop_generate_scalar or cloog_loop_generate_general
  * on each of the strongly connected components in the list of CloogLoops
@@ -2400,20 +4331,30 @@ static int extract_component(CloogLoop **loop_array, int *list, CloogLoop **res)
  * The components are treated separately to avoid spurious separations.
  * The concatentation of the results may contain successive loops
  * with the same bounds, so we try to combine such loops.
+ *
+ * Since the components are independent, they are generated
+ * by several threads if the user asked for it (and strides are not
+ * being handled, since strides cannot be copied to other states,
+ * and the state does not keep the components it generates).
+ * The components are then only collected by the loop below and generated
+ * afterwards.  The result is the same in both cases.
  */
 CloogLoop *cloog_loop_generate_components(CloogLoop *loop,
 	int level, int scalar, int *scaldims, int nb_scattdims,
 	CloogOptions *options)
 {
-    int i, nb_loops;
+    int i, nb_loops, nb_components, parallel;
     CloogLoop *tmp;
     CloogLoop *res, **res_next;
-    CloogLoop **loop_array;
+    CloogLoop **loop_array, **components = NULL;
     struct cloog_loop_sort *s;
 
-    if (level == 0 || !loop->next)
+    if (level == 0)
 	return cloog_loop_generate_general(loop, level, scalar,
 					     scaldims, nb_scattdims, options);
+    if (!loop->next)
+	return cloog_loop_generate_component(loop, level, scalar,
+					     scaldims, nb_scattdims, options);
 
     nb_loops = cloog_loop_count(loop);
 
@@ -2431,19 +4372,50 @@ CloogLoop *cloog_loop_generate_components(CloogLoop *loop,
 					nb_scattdims, &inner_loop_follows);
     }
 
+#ifdef CLOOG_PTHREADS
+    parallel = options->threads > 1 && !cloog_loop_may_stride(options) &&
+		!loop->state->components && s->op - nb_loops > 1;
+#else
+    parallel = 0;
+#endif
+    if (parallel) {
+	components = (CloogLoop **)malloc((s->op - nb_loops) *
+						sizeof(CloogLoop *));
+	assert(components);
+    }
+
     i = 0;
+    nb_components = 0;
     res = NULL;
     res_next = &res;
     while (nb_loops) {
 	int n = extract_component(loop_array, &s->order[i], &tmp);
 	i += n + 1;
 	nb_loops -= n;
-	*res_next = cloog_loop_generate_general(tmp, level, scalar,
+	if (parallel) {
+	    components[nb_components++] = tmp;
+	    continue;
+	}
+	*res_next = cloog_loop_generate_component(tmp, level, scalar,
 					     scaldims, nb_scattdims, options);
     	while (*res_next)
 	    res_next = &(*res_next)->next;
     }
 
+#ifdef CLOOG_PTHREADS
+    if (parallel) {
+	struct cloog_loop_tasks tasks;
+
+	tasks.fn = &task_generate_general;
+	tasks.level = level;
+	tasks.scalar = scalar;
+	tasks.scaldims = scaldims;
+	tasks.nb_scattdims = nb_scattdims;
+	res = cloog_loop_parallel(components, nb_components, &tasks, options);
+	free(components);
+    }
+#endif
+
     cloog_loop_sort_free(s);
 
     free(loop_array);
@@ -2612,12 +4584,13 @@ static CloogLoop *loop_simplify(CloogLoop *loop, CloogDomain *context,
   
   domain_dim = cloog_domain_dimension(domain);
   extended_context = cloog_domain_extend(context, domain_dim);
-  inter = cloog_domain_intersection(domain,extended_context) ;
-  simp = cloog_domain_simplify(domain, extended_context);
+  inter = cloog_domain_intersection_cached(loop->state, domain,
+					   extended_context);
+  simp = cloog_domain_simplify_cached(loop->state, domain, extended_context);
   cloog_domain_free(extended_context) ;
 
   /* If the constraint system is never true, go to the next one. */
-  if (cloog_domain_never_integral(simp)) {
+  if (cloog_domain_never_integral_cached(loop->state, simp)) {
     cloog_loop_free(loop->inner);
     cloog_domain_free(inter);
     cloog_domain_free(simp);
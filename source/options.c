@@ -138,6 +138,24 @@ void cloog_options_print(FILE * foo, CloogOptions * options)
   fprintf(foo,"stop        = %3d,\n",options->stop) ;
   fprintf(foo,"strides     = %3d,\n",options->strides) ;
   fprintf(foo,"sh          = %3d,\n",options->sh);
+  fprintf(foo,"unroll_depth = %3d,\n",options->unroll_depth);
+  fprintf(foo,"unroll_factor = %3d,\n",options->unroll_factor);
+  if (options->unroll_factors_size >= 1) {
+      fprintf(foo,"unroll_factors = ");
+      for (i=0; i<options->unroll_factors_size; i++) {
+          fprintf(foo,"%3d,\n",options->unroll_factors[i]) ;
+      }
+      fprintf(foo,"\n");
+  }
+  fprintf(foo,"full_tiles  = %3d,\n",options->full_tiles);
+  fprintf(foo,"threads     = %3d,\n",options->threads);
+  fprintf(foo,"threads_depth = %3d,\n",options->threads_depth);
+  fprintf(foo,"separate_budget = %3d,\n",options->separate_budget);
+  fprintf(foo,"size_budget = %3d,\n",options->size_budget);
+  fprintf(foo,"max_operations = %3d,\n",options->max_operations);
+  fprintf(foo,"hoist       = %3d,\n",options->hoist);
+  fprintf(foo,"tune        = %3d,\n",options->tune);
+  fprintf(foo,"nb_versions = %3d,\n",options->nb_versions);
   fprintf(foo,"OPTIONS FOR PRETTY PRINTING\n") ;
   fprintf(foo,"esp         = %3d,\n",options->esp) ;
   fprintf(foo,"fsp         = %3d,\n",options->fsp) ;
@@ -148,6 +166,7 @@ void cloog_options_print(FILE * foo, CloogOptions * options)
   fprintf(foo,"MISC OPTIONS\n") ;
   fprintf(foo,"name        = %3s.\n", options->name);
   fprintf(foo,"openscop    = %3d.\n", options->openscop);
+  fprintf(foo,"stream      = %3d.\n", options->stream);
   if (options->scop != NULL)
     fprintf(foo,"scop        = (present but not printed).\n");
   else
@@ -175,6 +194,8 @@ void cloog_options_print(FILE * foo, CloogOptions * options)
  */
 void cloog_options_free(CloogOptions *options)
 {
+  int i;
+
 #ifdef OSL_SUPPORT
   if (options->scop != NULL) {
     osl_scop_free(options->scop);
@@ -182,6 +203,10 @@ void cloog_options_free(CloogOptions *options)
 #endif
   free(options->fs);
   free(options->ls);
+  free(options->unroll_factors);
+  for (i = 0; i < options->nb_versions; ++i)
+    cloog_domain_free(options->versions[i]);
+  free(options->versions);
   free(options);
 }
 
@@ -213,6 +238,46 @@ void cloog_options_help()
   "                        (default setting:  0).\n"
   "  -first-unroll <depth> First loop dimension to unroll (-1: no unrolling)\n");
   printf(
+  "  -unroll-depth <depth> Scattering dimension to unroll partially, by the\n"
+  "                        factor given by -unroll-factor (-1: none)\n"
+  "                        (default setting: -1).\n"
+  "  -unroll-factor <n>    Partial unroll factor (default setting:  4).\n"
+  "  -full-tiles <depth>   Depth of the innermost tile loops, split into full\n"
+  "                        and partial tiles (-1: none) (default setting: -1).\n");
+  printf(
+  "  -threads <number>     Number of threads generating independent loop nests"
+  "\n                        (default setting:  1).\n");
+  printf(
+  "  -threads-depth <depth> Last loop depth whose sibling loops are generated\n"
+  "                        in parallel (-1: infinity) (default setting:  2).\n");
+  printf(
+  "  -separate-budget <n>  Maximum number of polyhedra to separate the loops\n"
+  "                        of a depth, merge them beyond (-1: infinity)\n"
+  "                        (default setting: -1).\n");
+  printf(
+  "  -size-budget <n>      Choose between separation and merging at each\n"
+  "                        depth, separating only if the loops are copied\n"
+  "                        at most <n> times on average (-1: use -f/-l)\n"
+  "                        (default setting: -1).\n");
+  printf(
+  "  -max-operations <n>   Maximum number of isl operations before using\n"
+  "                        the next cheaper strategy, counted again after\n"
+  "                        each switch (-1: infinity)\n"
+  "                        (default setting: -1).\n");
+  printf(
+  "  -hoist <boolean>      Hoist the guards of inner loops into the outer\n"
+  "                        loops (1) or not (0) (default setting:  0).\n");
+  printf(
+  "  -tune <metric>        Try several configurations of -f/-l, -otl, -sh,\n"
+  "                        -backtrack, -strides and -first-unroll, -threads\n"
+  "                        at a time, and keep the one whose code has the\n"
+  "                        fewest nodes (1) or guards (2), or don't (0)\n"
+  "                        (default setting:  0).\n");
+  printf(
+  "  -specialize <file>    Generate a version of the code specialised to the\n"
+  "                        parameter domain in <file> (same format as the\n"
+  "                        context), selected at run time; may be repeated.\n");
+  printf(
   "\nOptions for pretty printing:\n"
   "  -otl <boolean>        Simplify loops running one time (1) or not (0)\n"
   "                        (default setting:  1).\n") ;
@@ -240,6 +305,13 @@ void cloog_options_help()
 #endif
   "  -v, --version         Display the version information (and more).\n"
   "  -q, --quiet           Don't print any informational messages.\n"
+  "  -arena                Allocate the loops, blocks and statements from\n"
+  "                        an arena released at the end.\n"
+  "  -memo <n>             Remember the results of the last <n> domain\n"
+  "                        operations (default setting: 0, i.e., none).\n"
+  "  -stream               Generate and print the code of each group of\n"
+  "                        statements with the same leading scalar\n"
+  "                        dimensions in turn.\n"
   "  -h, --help            Display this information.\n\n") ;
   printf(
   "The special value 'stdin' for 'file' makes CLooG to read data on\n"
@@ -312,6 +384,37 @@ void cloog_options_set(int * option, int argv, char ** argc, int * number)
 }
 
 
+/**
+ * cloog_options_read_version function:
+ * This function reads the parameter domain of a specialised version of the
+ * code from the file given on the user's calling line, in the same format as
+ * the context, and appends it to options->versions.
+ * - argc are the elements of the user's calling line,
+ * - number is the number of the element corresponding to the considered option,
+ *   this function adds 1 to number to pass away the option value.
+ */
+static void cloog_options_read_version(CloogOptions *options,
+				       int argv, char **argc, int *number)
+{ FILE *file;
+
+  if (*number+1 >= argv)
+    cloog_die("an option lacks of argument.\n");
+
+  file = fopen(argc[*number+1], "r");
+  if (file == NULL)
+    cloog_die("can't open version file %s.\n", argc[*number+1]);
+
+  options->versions = (CloogDomain **)realloc(options->versions,
+			(options->nb_versions + 1) * sizeof(CloogDomain *));
+  if (options->versions == NULL)
+    cloog_die("memory overflow.\n");
+  options->versions[options->nb_versions++] =
+		cloog_domain_read_context(options->state, file);
+  fclose(file);
+  *number = *number + 1 ;
+}
+
+
 /**
  * cloog_options_malloc function:
  * This functions allocate the memory space for a CLoogOptions structure and
@@ -341,6 +444,20 @@ CloogOptions *cloog_options_malloc(CloogState *state)
   options->strides     =  0 ;  /* Generate a code with unit strides. */
   options->sh	       =  0;   /* Compute actual convex hull. */
   options->first_unroll = -1;  /* First level to unroll: none. */
+  options->unroll_depth = -1;  /* Level to unroll partially: none. */
+  options->unroll_factor = 4;  /* Four iterations at a time. */
+  options->unroll_factors = NULL; /* Statement-wise factors are not set. */
+  options->unroll_factors_size = 0;
+  options->full_tiles = -1;    /* Do not separate full tiles. */
+  options->threads     =  1 ;  /* Sequential code generation. */
+  options->threads_depth = 2;  /* Parallel recursion in the two outer levels. */
+  options->separate_budget = -1; /* No limit on separation. */
+  options->size_budget = -1;   /* Separation depths given by f and l. */
+  options->max_operations = -1; /* No limit on isl operations. */
+  options->hoist       =  0;   /* Don't hoist guards. */
+  options->tune        =  CLOOG_TUNE_NONE; /* Use the options as given. */
+  options->versions    = NULL; /* No specialised versions. */
+  options->nb_versions =  0;
   options->name	       = "";
   /* OPTIONS FOR PRETTY PRINTING */
   options->esp         =  1 ;  /* We want Equality SPreading.*/
@@ -350,11 +467,13 @@ CloogOptions *cloog_options_malloc(CloogState *state)
   options->compilable  =  0 ;  /* No compilable code. */
   options->callable    =  0 ;  /* No callable code. */
   options->quiet       =  0;   /* Do print informational messages. */
+  options->stream      =  0;   /* Generate all the code before printing it. */
   options->save_domains = 0;   /* Don't save domains. */
   /* MISC OPTIONS */
   options->language    = CLOOG_LANGUAGE_C; /* The default output language is C. */
   options->openscop    =  0 ;  /* The input file has not the OpenScop format.*/
   options->scop        =  NULL;/* No default SCoP.*/
+  options->fallback    = CLOOG_FALLBACK_NONE; /* No fallback used (yet). */
   /* UNDOCUMENTED OPTIONS FOR THE AUTHOR ONLY */
   options->leaks       =  0 ;  /* I don't want to print allocation statistics.*/
   options->backtrack   =  0;   /* Perform backtrack in Quillere's algorithm.*/
@@ -404,6 +523,40 @@ void cloog_options_read(CloogState *state, int argc, char **argv,
       cloog_options_set(&(*options)->sh,argc,argv,&i) ;
     else if (!strcmp(argv[i], "-first-unroll"))
       cloog_options_set(&(*options)->first_unroll, argc, argv, &i);
+    else if (!strcmp(argv[i], "-unroll-depth"))
+      cloog_options_set(&(*options)->unroll_depth, argc, argv, &i);
+    else if (!strcmp(argv[i], "-unroll-factor")) {
+      cloog_options_set(&(*options)->unroll_factor, argc, argv, &i);
+      if ((*options)->unroll_factor < 2) {
+        cloog_msg(*options, CLOOG_ERROR,
+		  "-unroll-factor should be at least 2.\n");
+        exit(1);
+      }
+    }
+    else if (!strcmp(argv[i], "-full-tiles"))
+      cloog_options_set(&(*options)->full_tiles, argc, argv, &i);
+    else if (!strcmp(argv[i], "-threads"))
+      cloog_options_set(&(*options)->threads, argc, argv, &i);
+    else if (!strcmp(argv[i], "-threads-depth"))
+      cloog_options_set(&(*options)->threads_depth, argc, argv, &i);
+    else if (!strcmp(argv[i], "-separate-budget"))
+      cloog_options_set(&(*options)->separate_budget, argc, argv, &i);
+    else if (!strcmp(argv[i], "-size-budget"))
+      cloog_options_set(&(*options)->size_budget, argc, argv, &i);
+    else if (!strcmp(argv[i], "-max-operations"))
+      cloog_options_set(&(*options)->max_operations, argc, argv, &i);
+    else if (!strcmp(argv[i], "-hoist"))
+      cloog_options_set(&(*options)->hoist, argc, argv, &i);
+    else if (!strcmp(argv[i], "-tune"))
+      cloog_options_set(&(*options)->tune, argc, argv, &i);
+    else if (!strcmp(argv[i], "-specialize"))
+      cloog_options_read_version(*options, argc, argv, &i);
+    else if (!strcmp(argv[i], "-arena"))
+      cloog_state_use_arena(state);
+    else if (!strcmp(argv[i], "-memo"))
+      cloog_options_set(&state->memo_size, argc, argv, &i);
+    else if (!strcmp(argv[i], "-stream"))
+      (*options)->stream = 1;
     else
     if (strcmp(argv[i],"-otl") == 0)
     cloog_options_set(&(*options)->otl,argc,argv,&i) ;
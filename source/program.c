@@ -46,6 +46,9 @@
 # include <string.h>
 # include <ctype.h>
 # include <unistd.h>
+#ifdef CLOOG_FORK
+# include <sys/wait.h>
+#endif
 # include "../include/cloog/cloog.h"
 #ifdef CLOOG_RUSAGE
 # include <sys/resource.h>
@@ -608,24 +611,19 @@ int cloog_program_osl_pprint(FILE * file, CloogProgram * program,
 }
 
 /**
- * cloog_program_pprint function:
- * This function prints the content of a CloogProgram structure (program) into a
- * file (file, possibly stdout), in a C-like language.
- * - June 22nd 2005: Adaptation for GMP.
+ * cloog_program_pprint_begin function:
+ * This function prints what comes before the code of a CloogProgram structure
+ * (program) into a file (file, possibly stdout) and returns the indentation
+ * of the code.  The time spent for code generation is only printed if
+ * (timed) is set, i.e., if the code has already been generated.
  */
-void cloog_program_pprint(file, program, options)
-FILE * file ;
-CloogProgram * program ;
-CloogOptions * options ;
+static int cloog_program_pprint_begin(FILE *file, CloogProgram *program,
+				      CloogOptions *options, int timed)
 {
   int i, j, indentation = 0;
   CloogStatement * statement ;
   CloogBlockList * blocklist ;
   CloogBlock * block ;
-  struct clast_stmt *root;
-
-  if (cloog_program_osl_pprint(file, program, options))
-    return;
 
   if (program->language == 'f')
     options->language = CLOOG_LANGUAGE_FORTRAN ;
@@ -633,16 +631,19 @@ CloogOptions * options ;
     options->language = CLOOG_LANGUAGE_C ;
  
 #ifdef CLOOG_RUSAGE
-  print_comment(file, options, "Generated from %s by %s in %.2fs.",
-		options->name, cloog_version(), options->time);
-#else
+  if (timed)
+    print_comment(file, options, "Generated from %s by %s in %.2fs.",
+		  options->name, cloog_version(), options->time);
+  else
+#endif
   print_comment(file, options, "Generated from %s by %s.",
 		options->name, cloog_version());
-#endif
 #ifdef CLOOG_MEMORY
-  print_comment(file, options, "CLooG asked for %d KBytes.", options->memory);
-  cloog_msg(CLOOG_INFO, "%.2fs and %dKB used for code generation.\n",
-	  options->time,options->memory);
+  if (timed) {
+    print_comment(file, options, "CLooG asked for %d KBytes.", options->memory);
+    cloog_msg(CLOOG_INFO, "%.2fs and %dKB used for code generation.\n",
+	    options->time,options->memory);
+  }
 #endif
   
   /* If the option "compilable" is set, we provide the whole stuff to generate
@@ -716,11 +717,19 @@ CloogOptions * options ;
     print_callable_preamble(file, program, options);
     indentation += 2;
   }
-  
-  root = cloog_clast_create(program, options);
-  clast_pprint(file, root, indentation, options);
-  cloog_clast_free(root);
-  
+
+  return indentation;
+}
+
+
+/**
+ * cloog_program_pprint_end function:
+ * This function prints what comes after the code of a CloogProgram structure
+ * (program) into a file (file, possibly stdout).
+ */
+static void cloog_program_pprint_end(FILE *file, CloogProgram *program,
+				     CloogOptions *options)
+{
   /* The end of the compilable code in case of 'compilable' option. */
   if (options->compilable && (program->language == 'c'))
   {
@@ -731,6 +740,33 @@ CloogOptions * options ;
 }
 
 
+/**
+ * cloog_program_pprint function:
+ * This function prints the content of a CloogProgram structure (program) into a
+ * file (file, possibly stdout), in a C-like language.
+ * - June 22nd 2005: Adaptation for GMP.
+ */
+void cloog_program_pprint(file, program, options)
+FILE * file ;
+CloogProgram * program ;
+CloogOptions * options ;
+{
+  int indentation;
+  struct clast_stmt *root;
+
+  if (cloog_program_osl_pprint(file, program, options))
+    return;
+
+  indentation = cloog_program_pprint_begin(file, program, options, 1);
+  
+  root = cloog_clast_create(program, options);
+  clast_pprint(file, root, indentation, options);
+  cloog_clast_free(root);
+  
+  cloog_program_pprint_end(file, program, options);
+}
+
+
 /******************************************************************************
  *                         Memory deallocation function                       *
  ******************************************************************************/
@@ -819,6 +855,7 @@ CloogProgram *cloog_program_alloc(CloogDomain *context, CloogUnionDomain *ud,
 
     scatteringl = NULL;
     for (i = 0, l = ud->domain; l; ++i, l = l->next) {
+      l->domain = cloog_domain_intern(options->state, l->domain);
       *next = cloog_loop_from_domain(options->state, l->domain, i);
       l->domain = NULL;
       (*next)->block->statement->name = l->name;
@@ -945,33 +982,15 @@ CloogProgram * cloog_program_malloc()
 
 
 /**
- * cloog_program_generate function:
- * This function calls the Quillere algorithm for loop scanning. (see the
- * Quillere paper) and calls the loop simplification function.
- * - depth is the loop depth we want to optimize (guard free as possible),
- *   the first loop depth is 1 and anegative value is the infinity depth.
- * - sep_level is the level number where we want to start loop separation.
- **
- * - October 26th 2001: first version. 
- * - April   19th 2005: some basic fixes and memory usage feature.
- * - April   29th 2005: (bug fix, bug found by DaeGon Kim) see case 2 below.
- */ 
-CloogProgram * cloog_program_generate(program, options)
-CloogProgram * program ;
-CloogOptions * options ;
+ * cloog_program_check_options function:
+ * This function warns about dangerous combinations of options for generating
+ * the code of (program) and corrects them unless the user asked to override
+ * CLooG decisions.
+ */
+static void cloog_program_check_options(CloogProgram *program,
+					CloogOptions *options)
 {
-#ifdef CLOOG_RUSAGE
-  float time;
-  struct rusage start, end ;
-#endif
-  CloogLoop * loop ;
-#ifdef CLOOG_MEMORY
-  char status_path[MAX_STRING_VAL] ;
-  FILE * status ;
- 
-  /* We initialize the memory need to 0. */
-  options->memory = 0 ;
-#endif
+  int i;
 
   if (options->override)
   {
@@ -1013,18 +1032,109 @@ CloogOptions * options ;
       options->l = program->nb_scattdims ;
     }
   }
-  
+
+#ifndef CLOOG_PTHREADS
+  if (options->threads > 1)
+    cloog_msg(options, CLOOG_WARNING,
+    "CLooG has been built without thread support, the -threads "
+    "option\n                is ignored.\n");
+#endif
+
+  if (options->unroll_depth > program->nb_scattdims)
+    cloog_msg(options, CLOOG_WARNING,
+    "-unroll-depth is more than the scattering dimension number, "
+    "only\n                scattering dimensions are unrolled partially, "
+    "the option is\n                ignored.\n");
+
+  for (i = 0; i < options->nb_versions; ++i)
+    if (cloog_domain_parameter_dimension(options->versions[i]) !=
+	cloog_domain_parameter_dimension(program->context))
+      cloog_die("the parameter domain of version %d does not have the "
+		"parameters of the context.\n", i + 1);
+}
+
+
+/**
+ * cloog_program_generate_versions function:
+ * This function generates the code scanning the list of loops (loop), part
+ * of (program), once for each parameter domain of options->versions, minus
+ * the domains of the previous versions, and once for the remaining values
+ * of the parameters.  Each version is generated with the context refined
+ * by its parameter domain, so that it does not need the guards and bounds
+ * that are only required for other values of the parameters.  The loops of
+ * a version are only simplified with respect to the original context, such
+ * that the guards on the parameters of their outermost loops select the
+ * version at run time.  Empty versions are skipped.
+ */
+static CloogLoop *cloog_program_generate_versions(CloogProgram *program,
+						  CloogLoop *loop,
+						  CloogOptions *options)
+{
+  int i;
+  CloogLoop *res = NULL, *version;
+  CloogDomain *seen, *context, *temp;
+
+  seen = cloog_domain_empty(program->context);
+  for (i = 0; i <= options->nb_versions; ++i) {
+    if (i < options->nb_versions) {
+      temp = cloog_domain_intersection(program->context, options->versions[i]);
+      context = cloog_domain_difference(temp, seen);
+      seen = cloog_domain_union(seen, temp);
+    } else
+      context = cloog_domain_difference(program->context, seen);
+
+    if (cloog_domain_isempty(context)) {
+      cloog_domain_free(context);
+      if (i == options->nb_versions)
+	cloog_loop_free(loop);
+      continue;
+    }
+
+    version = i < options->nb_versions ? cloog_loop_copy(loop) : loop;
+    version = cloog_loop_generate(version, context, 0, 0, program->scaldims,
+				  program->nb_scattdims, options);
+    cloog_domain_free(context);
+    res = cloog_loop_concat(res, version);
+  }
+  cloog_domain_free(seen);
+
+  return res;
+}
+
+
+/**
+ * cloog_program_generate_loop function:
+ * This function generates the code scanning the list of loops (loop), part
+ * of (program), and simplifies it.  The time spent is added to
+ * options->time.
+ */
+static CloogLoop *cloog_program_generate_loop(CloogProgram *program,
+					      CloogLoop *loop,
+					      CloogOptions *options)
+{
+#ifdef CLOOG_RUSAGE
+  float time;
+  struct rusage start, end ;
+#endif
+#ifdef CLOOG_MEMORY
+  char status_path[MAX_STRING_VAL] ;
+  FILE * status ;
+#endif
+
 #ifdef CLOOG_RUSAGE
   getrusage(RUSAGE_SELF, &start) ;
 #endif
-  if (program->loop != NULL)
-  { loop = program->loop ;
-    
-    /* Here we go ! */
-    loop = cloog_loop_generate(loop, program->context, 0, 0,
-                               program->scaldims,
-			       program->nb_scattdims,
-			       options);
+  if (loop != NULL)
+  { /* Here we go ! */
+    cloog_state_set_max_operations(options->state, options->max_operations);
+    if (options->nb_versions > 0)
+      loop = cloog_program_generate_versions(program, loop, options);
+    else
+      loop = cloog_loop_generate(loop, program->context, 0, 0,
+                                 program->scaldims,
+			         program->nb_scattdims,
+			         options);
+    cloog_state_set_max_operations(options->state, -1);
 			          
 #ifdef CLOOG_MEMORY
     /* We read into the status file of the process how many memory it uses. */
@@ -1035,11 +1145,9 @@ CloogOptions * options ;
     fclose(status) ;
 #endif
     
-    if ((!options->nosimplify) && (program->loop != NULL))
+    if ((!options->nosimplify) && (loop != NULL))
       loop = cloog_loop_simplify(loop, program->context, 0,
                                  program->nb_scattdims, options);
-   
-    program->loop = loop ;
   }
     
 #ifdef CLOOG_RUSAGE
@@ -1047,13 +1155,432 @@ CloogOptions * options ;
   /* We calculate the time spent in code generation. */
   time =  (end.ru_utime.tv_usec -  start.ru_utime.tv_usec)/(float)(MEGA) ;
   time += (float)(end.ru_utime.tv_sec - start.ru_utime.tv_sec) ;
-  options->time = time ;
+  options->time += time ;
+#endif
+
+  return loop;
+}
+
+
+/**
+ * cloog_program_tune_count_expr function:
+ * This function returns the number of nodes of the clast expression (e).
+ */
+static int cloog_program_tune_count_expr(struct clast_expr *e)
+{
+  int i, n;
+  struct clast_reduction *r;
+
+  if (!e)
+    return 0;
+
+  switch (e->type) {
+  case clast_expr_name:
+    return 1;
+  case clast_expr_term:
+    return 1 + cloog_program_tune_count_expr(((struct clast_term *)e)->var);
+  case clast_expr_bin:
+    return 1 + cloog_program_tune_count_expr(((struct clast_binary *)e)->LHS);
+  case clast_expr_red:
+    r = (struct clast_reduction *)e;
+    for (i = 0, n = 1; i < r->n; ++i)
+      n += cloog_program_tune_count_expr(r->elts[i]);
+    return n;
+  }
+
+  return 0;
+}
+
+
+/**
+ * cloog_program_tune_count function:
+ * This function returns the number of nodes (statements and expressions)
+ * of the clast statement list (s) and adds the number of conditions of
+ * its guards to (guards).
+ */
+static int cloog_program_tune_count(struct clast_stmt *s, int *guards)
+{
+  int i, n = 0;
+
+  for (; s; s = s->next) {
+    n++;
+    if (CLAST_STMT_IS_A(s, stmt_ass))
+      n += cloog_program_tune_count_expr(((struct clast_assignment *)s)->RHS);
+    else if (CLAST_STMT_IS_A(s, stmt_user))
+      n += cloog_program_tune_count(((struct clast_user_stmt *)s)->substitutions,
+				    guards);
+    else if (CLAST_STMT_IS_A(s, stmt_block))
+      n += cloog_program_tune_count(((struct clast_block *)s)->body, guards);
+    else if (CLAST_STMT_IS_A(s, stmt_for)) {
+      struct clast_for *f = (struct clast_for *)s;
+      n += cloog_program_tune_count_expr(f->LB);
+      n += cloog_program_tune_count_expr(f->UB);
+      n += cloog_program_tune_count(f->body, guards);
+    } else if (CLAST_STMT_IS_A(s, stmt_guard)) {
+      struct clast_guard *g = (struct clast_guard *)s;
+      for (i = 0; i < g->n; ++i) {
+	n += cloog_program_tune_count_expr(g->eq[i].LHS);
+	n += cloog_program_tune_count_expr(g->eq[i].RHS);
+      }
+      *guards += g->n;
+      n += cloog_program_tune_count(g->then, guards);
+    }
+  }
+
+  return n;
+}
+
+
+/**
+ * Configuration of the generation options tried by cloog_program_tune,
+ * along with the size of the code it gives (nodes = -1 if unknown).
+ */
+struct cloog_tune_config {
+  int f, l, otl, sh, backtrack, strides, first_unroll;
+  int nodes, guards;
+};
+
+
+/**
+ * cloog_program_tune_configs function:
+ * This function fills (configs) with the configurations tried by
+ * cloog_program_tune and returns their number.  They are all the
+ * combinations of the depths of (options) to separate, no separation at
+ * all or separation at every depth, and of the values of (options) or the
+ * opposite ones for otl, sh, backtrack, strides and first_unroll (which
+ * unrolls from the first depth when not set).  The configuration of
+ * (options) itself comes first and duplicates are removed.
+ */
+static int cloog_program_tune_configs(CloogOptions *options,
+				      struct cloog_tune_config *configs)
+{
+  int i, j, k, n = 0;
+  struct cloog_tune_config c;
+
+  for (i = 0; i < 3 * 32; ++i) {
+    k = i >> 5;
+    c.f = k == 0 ? options->f : k == 1 ? -1 : 1;
+    c.l = k == 0 ? options->l : -1;
+    c.otl = (i & 1) ? !options->otl : options->otl;
+    c.sh = (i & 2) ? !options->sh : options->sh;
+    c.backtrack = (i & 4) ? !options->backtrack : options->backtrack;
+    c.strides = (i & 8) ? !options->strides : options->strides;
+    c.first_unroll = !(i & 16) ? options->first_unroll :
+		     options->first_unroll >= 0 ? -1 : 1;
+    c.nodes = c.guards = -1;
+
+    for (j = 0; j < n; ++j)
+      if (configs[j].f == c.f && configs[j].l == c.l &&
+	  configs[j].otl == c.otl && configs[j].sh == c.sh &&
+	  configs[j].backtrack == c.backtrack &&
+	  configs[j].strides == c.strides &&
+	  configs[j].first_unroll == c.first_unroll)
+	break;
+    if (j == n)
+      configs[n++] = c;
+  }
+
+  return n;
+}
+
+
+/**
+ * cloog_program_tune_apply function:
+ * This function sets the generation options of (options) to those of
+ * the configuration (config).
+ */
+static void cloog_program_tune_apply(CloogOptions *options,
+				     struct cloog_tune_config *config)
+{
+  options->f = config->f;
+  options->l = config->l;
+  options->otl = config->otl;
+  options->sh = config->sh;
+  options->backtrack = config->backtrack;
+  options->strides = config->strides;
+  options->first_unroll = config->first_unroll;
+}
+
+
+/**
+ * cloog_program_tune_measure function:
+ * This function generates the code of (program) with the options of
+ * (options) changed to (config) and stores its numbers of nodes and guards
+ * in (config).  The loops of (program) are copied and (program) is left
+ * untouched.  No message is printed and (threads) threads are used.
+ */
+static void cloog_program_tune_measure(CloogProgram *program,
+				       CloogOptions *options,
+				       struct cloog_tune_config *config,
+				       int threads)
+{
+  CloogProgram copy;
+  CloogOptions variant;
+  struct clast_stmt *root;
+
+  variant = *options;
+  cloog_program_tune_apply(&variant, config);
+  variant.tune = CLOOG_TUNE_NONE;
+  variant.threads = threads;
+  variant.quiet = 1;
+  variant.time = 0;
+  variant.fallback = CLOOG_FALLBACK_NONE;
+
+  copy = *program;
+  copy.loop = cloog_loop_copy(program->loop);
+  cloog_program_check_options(&copy, &variant);
+  copy.loop = cloog_program_generate_loop(&copy, copy.loop, &variant);
+
+  root = cloog_clast_create(&copy, &variant);
+  config->guards = 0;
+  config->nodes = cloog_program_tune_count(root, &config->guards);
+  cloog_clast_free(root);
+  cloog_loop_free(copy.loop);
+}
+
+
+#ifdef CLOOG_FORK
+/**
+ * cloog_program_tune_parallel function:
+ * This function measures the (n) configurations of (configs) in
+ * options->threads worker processes, each of which takes every
+ * options->threads-th configuration and sends back its measures
+ * through a pipe.  The processes share the input of the parent, which is
+ * therefore read only once.  If a worker cannot be started, its
+ * configurations are measured by the calling process instead.  The
+ * configurations of a worker that dies, e.g., because it runs out of
+ * memory, remain unknown.
+ */
+static void cloog_program_tune_parallel(CloogProgram *program,
+					CloogOptions *options,
+					struct cloog_tune_config *configs,
+					int n)
+{
+  int i, k, nb_workers, msg[3];
+  int *fd;
+  pid_t *pid;
+
+  nb_workers = options->threads < n ? options->threads : n;
+  fd = (int *)malloc(nb_workers * sizeof(int));
+  pid = (pid_t *)malloc(nb_workers * sizeof(pid_t));
+  if (!fd || !pid)
+    cloog_die("memory overflow.\n");
+
+  /* Nothing buffered must be written twice by the workers. */
+  fflush(NULL);
+
+  for (k = 0; k < nb_workers; ++k) {
+    int p[2];
+
+    pid[k] = -1;
+    fd[k] = -1;
+    if (pipe(p) < 0)
+      continue;
+    pid[k] = fork();
+    if (pid[k] == 0) {
+      close(p[0]);
+      for (i = k; i < n; i += nb_workers) {
+	cloog_program_tune_measure(program, options, &configs[i], 1);
+	msg[0] = i;
+	msg[1] = configs[i].nodes;
+	msg[2] = configs[i].guards;
+	if (write(p[1], msg, sizeof(msg)) != sizeof(msg))
+	  break;
+      }
+      _exit(0);
+    }
+    close(p[1]);
+    if (pid[k] < 0)
+      close(p[0]);
+    else
+      fd[k] = p[0];
+  }
+
+  for (k = 0; k < nb_workers; ++k) {
+    if (pid[k] < 0) {
+      for (i = k; i < n; i += nb_workers)
+	cloog_program_tune_measure(program, options, &configs[i], 1);
+      continue;
+    }
+    while (read(fd[k], msg, sizeof(msg)) == sizeof(msg))
+      if (msg[0] >= 0 && msg[0] < n) {
+	configs[msg[0]].nodes = msg[1];
+	configs[msg[0]].guards = msg[2];
+      }
+    close(fd[k]);
+    waitpid(pid[k], NULL, 0);
+  }
+
+  free(fd);
+  free(pid);
+}
+#endif
+
+
+/**
+ * cloog_program_tune function:
+ * This function tries several configurations of the options of (options)
+ * that change the generated code but not its meaning (see
+ * cloog_program_tune_configs) on (program), and sets the options of
+ * (options) to the configuration whose code is the smallest according to
+ * options->tune: the number of nodes or the number of conditions in guards
+ * of the clast, the other one breaking ties, then the order of the
+ * configurations, such that the options of the user are kept unless
+ * another configuration does strictly better.  The configurations are
+ * tried options->threads at a time in separate processes when CLooG has
+ * been built with support for them, one after the other otherwise.
+ * The loops of (program) are not modified.  It returns the index of the
+ * chosen configuration, 0 if the options are unchanged.
+ */
+int cloog_program_tune(CloogProgram *program, CloogOptions *options)
+{
+  int i, n, best = 0, first, second, best_first, best_second;
+  struct cloog_tune_config configs[3 * 32];
+  CloogComponents *components;
+
+  if (options->tune == CLOOG_TUNE_NONE || program->loop == NULL)
+    return 0;
+
+  n = cloog_program_tune_configs(options, configs);
+
+  /* The configurations must not replace the components kept for
+   * the actual generation.
+   */
+  components = options->state->components;
+  options->state->components = NULL;
+
+#ifdef CLOOG_FORK
+  if (options->threads > 1)
+    cloog_program_tune_parallel(program, options, configs, n);
+  else
+#endif
+  for (i = 0; i < n; ++i)
+    cloog_program_tune_measure(program, options, &configs[i],
+			       options->threads);
+
+  options->state->components = components;
+
+  best_first = best_second = -1;
+  for (i = 0; i < n; ++i) {
+    if (configs[i].nodes < 0)
+      continue;
+    first = options->tune == CLOOG_TUNE_GUARDS ? configs[i].guards
+					       : configs[i].nodes;
+    second = options->tune == CLOOG_TUNE_GUARDS ? configs[i].nodes
+						: configs[i].guards;
+    if (best_first < 0 || first < best_first ||
+	(first == best_first && second < best_second)) {
+      best = i;
+      best_first = first;
+      best_second = second;
+    }
+  }
+
+  if (best_first < 0)
+    return 0;
+
+  cloog_program_tune_apply(options, &configs[best]);
+  cloog_msg(options, CLOOG_INFO,
+	    "tried %d configurations, kept -f %d -l %d -otl %d -sh %d "
+	    "-strides %d -first-unroll %d%s\n             (%d nodes, "
+	    "%d guards).\n", n, options->f, options->l, options->otl,
+	    options->sh, options->strides, options->first_unroll,
+	    options->backtrack ? " -backtrack" : "",
+	    configs[best].nodes, configs[best].guards);
+
+  return best;
+}
+
+
+/**
+ * cloog_program_generate function:
+ * This function calls the Quillere algorithm for loop scanning. (see the
+ * Quillere paper) and calls the loop simplification function.
+ * - depth is the loop depth we want to optimize (guard free as possible),
+ *   the first loop depth is 1 and anegative value is the infinity depth.
+ * - sep_level is the level number where we want to start loop separation.
+ **
+ * - October 26th 2001: first version. 
+ * - April   19th 2005: some basic fixes and memory usage feature.
+ * - April   29th 2005: (bug fix, bug found by DaeGon Kim) see case 2 below.
+ */ 
+CloogProgram * cloog_program_generate(program, options)
+CloogProgram * program ;
+CloogOptions * options ;
+{
+#ifdef CLOOG_MEMORY
+  /* We initialize the memory need to 0. */
+  options->memory = 0 ;
 #endif
+
+  cloog_program_tune(program, options);
+  cloog_program_check_options(program, options);
+
+  options->time = 0;
+  options->fallback = CLOOG_FALLBACK_NONE ;
+  program->loop = cloog_program_generate_loop(program, program->loop, options);
   
   return program ;
 }
 
 
+/**
+ * cloog_program_stream function:
+ * This function generates and prints the code of a CloogProgram structure
+ * (program) into a file (file, possibly stdout) like cloog_program_generate
+ * followed by cloog_program_pprint, except that the statements are taken
+ * one group of statements with the same values for the scalar dimensions
+ * at the start of the scattering at a time: the code of each group is
+ * generated, printed and freed before the next group is considered, such that
+ * only the loops and the clast of the largest group are ever in memory.
+ * The groups are generated independently, so the conditions on the
+ * parameters are checked per group.  The whole program is generated first
+ * if it has to be printed in OpenScop format.
+ * The loops of (program) are consumed.
+ */
+void cloog_program_stream(FILE *file, CloogProgram *program,
+			  CloogOptions *options)
+{
+  int indentation;
+  CloogLoop *loop, *group;
+  struct clast_stmt *root;
+
+  if (options->scop) {
+    program = cloog_program_generate(program, options);
+    cloog_program_pprint(file, program, options);
+    return;
+  }
+
+#ifdef CLOOG_MEMORY
+  options->memory = 0 ;
+#endif
+
+  cloog_program_tune(program, options);
+  cloog_program_check_options(program, options);
+
+  options->time = 0;
+  options->fallback = CLOOG_FALLBACK_NONE ;
+  indentation = cloog_program_pprint_begin(file, program, options, 0);
+
+  loop = cloog_loop_scalar_sort(program->loop, 1, program->scaldims,
+				program->nb_scattdims, 0);
+  program->loop = NULL;
+  while ((group = cloog_loop_scalar_group(&loop, program->scaldims,
+					  program->nb_scattdims)) != NULL) {
+    program->loop = cloog_program_generate_loop(program, group, options);
+    if (program->loop) {
+      root = cloog_clast_create(program, options);
+      clast_pprint(file, root, indentation, options);
+      cloog_clast_free(root);
+      cloog_loop_free(program->loop);
+      program->loop = NULL;
+    }
+  }
+
+  cloog_program_pprint_end(file, program, options);
+}
+
+
 /**
  * cloog_program_block function:
  * this function gives a last chance to the lazy user to consider statement
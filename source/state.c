@@ -1,6 +1,26 @@
 #include <stdlib.h>
 #include "../include/cloog/cloog.h"
 
+/* Nodes are allocated from chunks of CLOOG_ARENA_CHUNK bytes, in units of
+ * CLOOG_ARENA_ALIGN bytes.  Freed nodes are kept in a free list per size,
+ * for nodes of up to CLOOG_ARENA_CLASSES units.  Larger nodes are left
+ * to malloc and free.
+ */
+#define CLOOG_ARENA_ALIGN	(2 * sizeof(void *))
+#define CLOOG_ARENA_CLASSES	32
+#define CLOOG_ARENA_CHUNK	(64 * 1024)
+
+struct cloogarena_node {
+  struct cloogarena_node *next;
+};
+
+struct cloogarena {
+  struct cloogarena_node *chunks;  /* The chunks, most recent first. */
+  char *top;                       /* First free byte of the current chunk. */
+  size_t left;                     /* Free bytes in the current chunk. */
+  struct cloogarena_node *free[CLOOG_ARENA_CLASSES + 1];
+};
+
 /**
  * Allocate state and initialize backend independent part.
  */
@@ -37,6 +57,13 @@ CloogState *cloog_core_state_malloc(void)
   state->statement_freed = 0;
   state->statement_max = 0;
 
+  state->memo_size = 0;
+  state->memo_hits = 0;
+  state->memo_misses = 0;
+
+  state->arena = NULL;
+  state->components = NULL;
+
   return state;
 }
 
@@ -45,8 +72,122 @@ CloogState *cloog_core_state_malloc(void)
  */
 void cloog_core_state_free(CloogState *state)
 {
+  struct cloogarena_node *chunk, *next;
+
+  if (state->arena) {
+    for (chunk = state->arena->chunks; chunk; chunk = next) {
+      next = chunk->next;
+      free(chunk);
+    }
+    free(state->arena);
+  }
   cloog_int_clear(state->zero);
   cloog_int_clear(state->one);
   cloog_int_clear(state->negone);
   free(state);
 }
+
+
+/**
+ * cloog_state_use_arena function:
+ * This function makes the CloogLoop, CloogBlock and CloogStatement
+ * structures of (state) be allocated from an arena that is released
+ * in one go when (state) is freed, instead of one by one with malloc.
+ * Freed structures are still counted by the allocation statistics and
+ * their memory is reused for the next structures of the same size.
+ * It has to be called before any of these structures is allocated
+ * in (state).
+ */
+void cloog_state_use_arena(CloogState *state)
+{
+  if (state->arena)
+    return;
+
+  state->arena = (CloogArena *)calloc(1, sizeof(CloogArena));
+  if (!state->arena)
+    cloog_die("memory overflow.\n");
+}
+
+
+/**
+ * cloog_state_reuse_components function:
+ * This function makes (state) keep the loops generated for each strongly
+ * connected component of the statements, keyed on the domains of
+ * the statements of the component, so that later calls of
+ * cloog_clast_create_from_input (or cloog_loop_generate) on the same state
+ * only generate the components that changed in between.  The components
+ * are kept until (state) is freed or until the code is generated with
+ * different options.  Components are not kept while handling strides
+ * or with a maximal number of isl operations and they are generated
+ * by a single thread.
+ */
+void cloog_state_reuse_components(CloogState *state)
+{
+  if (state->components)
+    return;
+
+  state->components = cloog_loop_components_alloc();
+}
+
+
+/**
+ * cloog_state_node_alloc function:
+ * This function allocates (size) bytes for a structure of (state),
+ * from the arena of (state) if it has one.
+ */
+void *cloog_state_node_alloc(CloogState *state, size_t size)
+{
+  CloogArena *arena = state->arena;
+  struct cloogarena_node *node;
+  size_t n = (size + CLOOG_ARENA_ALIGN - 1) / CLOOG_ARENA_ALIGN;
+  size_t header = CLOOG_ARENA_ALIGN;
+
+  if (!arena || n > CLOOG_ARENA_CLASSES) {
+    node = (struct cloogarena_node *)malloc(size);
+    if (!node)
+      cloog_die("memory overflow.\n");
+    return node;
+  }
+
+  if ((node = arena->free[n]) != NULL) {
+    arena->free[n] = node->next;
+    return node;
+  }
+
+  size = n * CLOOG_ARENA_ALIGN;
+  if (arena->left < size) {
+    node = (struct cloogarena_node *)malloc(CLOOG_ARENA_CHUNK);
+    if (!node)
+      cloog_die("memory overflow.\n");
+    node->next = arena->chunks;
+    arena->chunks = node;
+    arena->top = (char *)node + header;
+    arena->left = CLOOG_ARENA_CHUNK - header;
+  }
+  node = (struct cloogarena_node *)arena->top;
+  arena->top += size;
+  arena->left -= size;
+
+  return node;
+}
+
+
+/**
+ * cloog_state_node_free function:
+ * This function frees a structure of (size) bytes allocated by
+ * cloog_state_node_alloc for (state).
+ */
+void cloog_state_node_free(CloogState *state, void *node, size_t size)
+{
+  CloogArena *arena = state->arena;
+  struct cloogarena_node *free_node = (struct cloogarena_node *)node;
+  size_t n = (size + CLOOG_ARENA_ALIGN - 1) / CLOOG_ARENA_ALIGN;
+
+  if (!arena || n > CLOOG_ARENA_CLASSES) {
+    free(node);
+    return;
+  }
+
+  free_node->next = arena->free[n];
+  arena->free[n] = free_node;
+}
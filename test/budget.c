@@ -0,0 +1,13 @@
+/* Generated from budget.cloog by CLooG 0.20.0 gmp bits in 0.00s. */
+S3(2,1);
+for (i=3;i<=2*M;i++) {
+  if (i <= M+1) {
+    S1(i,1);
+  }
+  for (j=max(2,i-M);j<=floord(i-1,2);j++) {
+    S2(i,j);
+  }
+  if (i%2 == 0) {
+    S4(i,(i/2));
+  }
+}
@@ -0,0 +1,37 @@
+/* Generated from budget.cloog by CLooG 0.20.0 gmp bits in 0.00s. */
+extern void hash(int);
+
+/* Useful macros. */
+#define floord(n,d) (((n)<0) ? -((-(n)+(d)-1)/(d)) : (n)/(d))
+#define ceild(n,d)  (((n)<0) ? -((-(n))/(d)) : ((n)+(d)-1)/(d))
+#define max(x,y)    ((x) > (y) ? (x) : (y))
+#define min(x,y)    ((x) < (y) ? (x) : (y))
+
+#ifdef TIME 
+#define IF_TIME(foo) foo; 
+#else
+#define IF_TIME(foo)
+#endif
+
+#define S1(i,j) { hash(1); hash(i); hash(j); }
+#define S2(i,j) { hash(2); hash(i); hash(j); }
+#define S3(i,j) { hash(3); hash(i); hash(j); }
+#define S4(i,j) { hash(4); hash(i); hash(j); }
+
+void test(int M)
+{
+  /* Original iterators. */
+  int i, j;
+  S3(2,1);
+  for (i=3;i<=2*M;i++) {
+    if (i <= M+1) {
+      S1(i,1);
+    }
+    for (j=max(2,i-M);j<=floord(i-1,2);j++) {
+      S2(i,j);
+    }
+    if (i%2 == 0) {
+      S4(i,(i/2));
+    }
+  }
+}
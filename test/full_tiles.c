@@ -0,0 +1,12 @@
+/* Generated from test/full_tiles.cloog by CLooG 0.20.0-UNKNOWN gmp bits in 0.00s. */
+for (c1=0;c1<=floord(M-31,32);c1++) {
+  for (c2=32*c1;c2<=32*c1+31;c2++) {
+    S1(c1,c2);
+  }
+}
+if (M%32 <= 30) {
+  c1 = floord(M,32);
+  for (c2=32*c1;c2<=M;c2++) {
+    S1(c1,c2);
+  }
+}
@@ -0,0 +1,35 @@
+/* Generated from test/full_tiles.cloog by CLooG 0.20.0-UNKNOWN gmp bits in 0.00s. */
+extern void hash(int);
+
+/* Useful macros. */
+#define floord(n,d) (((n)<0) ? -((-(n)+(d)-1)/(d)) : (n)/(d))
+#define ceild(n,d)  (((n)<0) ? -((-(n))/(d)) : ((n)+(d)-1)/(d))
+#define max(x,y)    ((x) > (y) ? (x) : (y))
+#define min(x,y)    ((x) < (y) ? (x) : (y))
+
+#ifdef TIME 
+#define IF_TIME(foo) foo; 
+#else
+#define IF_TIME(foo)
+#endif
+
+#define S1(i,j) { hash(1); hash(i); hash(j); }
+
+void test(int M)
+{
+  /* Scattering iterators. */
+  int c1, c2;
+  /* Original iterators. */
+  int i, j;
+  for (c1=0;c1<=floord(M-31,32);c1++) {
+    for (c2=32*c1;c2<=32*c1+31;c2++) {
+      S1(c1,c2);
+    }
+  }
+  if (M%32 <= 30) {
+    c1 = floord(M,32);
+    for (c2=32*c1;c2<=M;c2++) {
+      S1(c1,c2);
+    }
+  }
+}
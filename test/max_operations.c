@@ -0,0 +1,14 @@
+/* Generated from max_operations.cloog by CLooG 0.20.0 gmp bits in 0.01s. */
+for (c1=1;c1<=N;c1++) {
+  S1(c1);
+}
+for (c1=N+1;c1<=M+2*N;c1++) {
+  for (i=1;i<=N;i++) {
+    if (c1 >= 2*N+1) {
+      S3(i,(c1-2*N));
+    }
+    if (c1 <= M+N) {
+      S2(i,(c1-N));
+    }
+  }
+}
@@ -0,0 +1,17 @@
+/* Generated from size_budget.cloog by CLooG 0.20.0 gmp bits. */
+for (i=2;i<=3;i++) {
+  for (j=-i+6;j<=6;j++) {
+    S1(i,j);
+  }
+}
+for (i=4;i<=7;i++) {
+  for (j=ceild(-i+13,3);j<=6;j++) {
+    if (i <= j+1) {
+      S1(i,j);
+    }
+    if (i == -j+9) {
+      S2(i,j);
+    }
+  }
+}
+S2(8,1);
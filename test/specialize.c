@@ -0,0 +1,11 @@
+/* Generated from test/specialize.cloog by CLooG 0.20.0-UNKNOWN gmp bits in 0.00s. */
+if (M <= 63) {
+  for (c1=0;c1<=M;c1++) {
+    S1(c1);
+  }
+}
+if (M >= 64) {
+  for (c1=0;c1<=63;c1++) {
+    S1(c1);
+  }
+}
@@ -0,0 +1,34 @@
+/* Generated from test/specialize.cloog by CLooG 0.20.0-UNKNOWN gmp bits in 0.00s. */
+extern void hash(int);
+
+/* Useful macros. */
+#define floord(n,d) (((n)<0) ? -((-(n)+(d)-1)/(d)) : (n)/(d))
+#define ceild(n,d)  (((n)<0) ? -((-(n))/(d)) : ((n)+(d)-1)/(d))
+#define max(x,y)    ((x) > (y) ? (x) : (y))
+#define min(x,y)    ((x) < (y) ? (x) : (y))
+
+#ifdef TIME 
+#define IF_TIME(foo) foo; 
+#else
+#define IF_TIME(foo)
+#endif
+
+#define S1(i) { hash(1); hash(i); }
+
+void test(int M)
+{
+  /* Scattering iterators. */
+  int c1;
+  /* Original iterators. */
+  int i;
+  if (M <= 63) {
+    for (c1=0;c1<=M;c1++) {
+      S1(c1);
+    }
+  }
+  if (M >= 64) {
+    for (c1=0;c1<=63;c1++) {
+      S1(c1);
+    }
+  }
+}
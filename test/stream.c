@@ -0,0 +1,11 @@
+/* Generated from stream.cloog by CLooG 0.20.0 gmp bits. */
+if (n >= 0) {
+  for (p3=0;p3<=n;p3++) {
+    S1(p3,0,0);
+  }
+}
+if (n >= 0) {
+  for (p3=0;p3<=n;p3++) {
+    S2(0,p3,0);
+  }
+}
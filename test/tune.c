@@ -0,0 +1,2 @@
+/* Generated from tune.cloog by CLooG 0.20.0 gmp bits. */
+S1(2*M,M);
@@ -0,0 +1,8 @@
+/* Generated from test/unroll_partial.cloog by CLooG 0.20.0-UNKNOWN gmp bits in 0.00s. */
+for (c1=0;c1<=M-1;c1+=2) {
+  S1(c1);
+  S1((c1+1));
+}
+if (M%2 == 0) {
+  S1(M);
+}
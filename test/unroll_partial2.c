@@ -0,0 +1,24 @@
+/* Generated from test/unroll_partial2.cloog by CLooG 0.20.0-UNKNOWN gmp bits in 0.01s. */
+for (c1=0;c1<=2*n-2;c1+=3) {
+  for (i=max(0,c1-n);i<=min(c1,n);i++) {
+    S1(i,(c1-i));
+  }
+  for (i=max(0,c1-n+1);i<=min(n,c1+1);i++) {
+    S1(i,(c1-i+1));
+  }
+  for (i=max(0,c1-n+2);i<=min(n,c1+2);i++) {
+    S1(i,(c1-i+2));
+  }
+}
+for (c1=max(0,2*n-1);c1<=2*n;c1++) {
+  if (c1%3 == 0) {
+    for (i=c1-n;i<=n;i++) {
+      S1(i,(c1-i));
+    }
+  }
+  if ((n+1)%3 == 0) {
+    if (c1 == 2*n) {
+      S1(n,n);
+    }
+  }
+}